@@ -3,22 +3,77 @@
  * @author 	Mahmoud Karam Emara (ma.karam272@gmail.com)
  * @brief 	Simple Traffic Light System with Pedeestrian Button
  * @details The system is in normal mode, and works as a traffic light system:
- *              * Green light for 5 seconds
- *              * Yellow light for 5 seconds
- *              * Red light for 5 seconds
+ *              * Green light while vehicles are coming (actuated, see below)
  *              * Yellow light for 5 seconds
+ *              * Red light for 5 seconds, or until a vehicle comes
  *              * Repeat
- *          If the pedestrian button is pressed, the system will be in pedestrian
- *          mode:
- *              * If the button is pressed while the cars are in RED light, the
- *                  pedestrian light will be GREEN and cars' light will be RED 
- *                  for 5 seconds
- *              * If the button is pressed while the cars are in GREEN light, or 
- *                  YELLOW is blinking, the pedestrian light will be RED, and both 
- *                  cars' and pedestrian's lights will be YELLOW blinking for 5 
- *                  seconds, then the pedestrian light will be GREEN and cars'
- *                  light will be RED for 5 seconds
+ *          The cars' green is actuated by the cars' detector, with the times
+ *          of the current timing plan:
+ *              * It lasts at least the plan's MIN_GREEN_MS
+ *              * Each vehicle extends it by the plan's PASSAGE_MS
+ *              * It ends when no vehicle comes for PASSAGE_MS (gap-out)
+ *                  or after MAX_GREEN_MS (max-out)
+ *              * It is skipped if no vehicle came during the red
+ *          The plan follows the time of day schedule of the RTC. A new plan is
+ *          taken at the end of a cycle only: the end of the cars' red or of the
+ *          pedestrian's final state. In the night flash plan the cars' yellow blinks
+ *          and the pedestrian calls are dropped.
+ *          A press of the pedestrian button is latched as a pedestrian call, 
+ *          with its time. A call is never lost, and is served within 
+ *          PED_MAX_WAIT_MS:
+ *              * If the cars are in RED light, the pedestrian light will be 
+ *                  GREEN and cars' light will be RED for 5 seconds
+ *              * If the cars are in GREEN light, the green ends normally or, 
+ *                  when the wait reaches its limit, the pedestrian light will be 
+ *                  RED, and both cars' and pedestrian's lights will be YELLOW 
+ *                  blinking for 5 seconds, then the pedestrian light will be 
+ *                  GREEN and cars' light will be RED for 5 seconds
+ *              * If YELLOW is blinking, the call is served at the next RED
+ *              * A press during the pedestrian GREEN is served immediately, a
+ *                  press during the other pedestrian states waits for the next 
+ *                  pedestrian GREEN
  *              At the end of both states, the system will be in normal mode
+ *          The wait of every served call is kept in a histogram, see
+ *          \ref APP_GetPedestrianWaitPercentile
+ *          In coordination, while the corridor sync pulses come on EXTI_1, the 
+ *          cars' green is no more actuated: it is held so that the cycle lasts
+ *          COORD_CYCLE_MS, minus a correction of the phase error measured at 
+ *          its start, see \ref APP_GetPhaseErrorUs
+ *          The command link reads the live state, the counters and the speed 
+ *          trap over the UART, and writes the time of day and the times of 
+ *          the plans, see \ref APP_COMMAND_t. The plans are written in a 
+ *          staged copy, or loaded in it from the EEPROM, that replaces the 
+ *          plans in use at the next cycle boundary
+ *          After a watchdog or brown-out reset, the state is resumed from a 
+ *          copy kept in .noinit RAM, see \ref APP_Resume
+ *          A lamp write that fails leaves the lamps unknown: the hardware 
+ *          failsafe flash takes over until the next reset, see 
+ *          \ref FAILSAFE_Enter
+ *          The pedestrians see the seconds left of their states on a seven 
+ *          segment display, and hear the tones of an accessible pedestrian
+ *          signal: the walk tone during their green, the locator tone that 
+ *          leads to the button otherwise
+ *          The technicians read the state, the plan, the time of day and the
+ *          lamp faults on a character LCD in the cabinet, see 
+ *          \ref APP_ShowStatus
+ *          They also work the maintenance keypad: a plan forced over the 
+ *          schedule, and the pedestrian and cars' calls placed by hand, see
+ *          \ref APP_ReadKeypad
+ *          A bus on the main road gets priority from the transit receiver: the
+ *          cars' green is extended for it, or comes early, within limits, 
+ *          then a few cycles run without priority. The delay saved is counted
+ *          in the EEPROM, see \ref APP_ServeTransit
+ *          In the adaptive mode, the max green of the cars follows the demand 
+ *          measured over the last cycles: the volume and the occupancy of the
+ *          detectors and the pedestrian phases served, see \ref APP_Adapt
+ *          An emergency vehicle on the main road preempts the cycle from the
+ *          receiver on EXTI_2: the yellow or the pedestrian's clearance in 
+ *          progress ends, then the all red, then the cars' green is held for 
+ *          it, see \ref APP_Preempt. The call is taken at the next update, 
+ *          the latency and the longest period of the loop are measured, see 
+ *          \ref APP_GetPreemptLatencyUs and \ref APP_TimeLoop
+ *          The state machine never blocks, it is polled from APP_Start and 
+ *          timed by the 1 ms system tick.
  *
  * @version 1.0.0
  * @date 	23 Sep 2022
@@ -35,30 +90,95 @@
 #include "../LIB/BIT_MATH.h"
 
 #include "../MCAL/DIO/DIO.h"
+#include "../MCAL/GIE/GIE.h"
 #include "../MCAL/EXTI/EXTI.h"
 #include "../MCAL/TIMER/TIMER.h"
+#include "../MCAL/EEPROM/EEPROM.h"
+#include "../MCAL/WDT/WDT.h"
+#include "../MCAL/ADC/ADC.h"
+#include "../MCAL/UART/UART.h"
+#include "../MCAL/TWI/TWI.h"
 
 #include "../HAL/LED/LED.h"
 #include "../HAL/BUTTON/BUTTON.h"
+#include "../HAL/COUNTER/COUNTER.h"
+#include "../HAL/SPEED/SPEED.h"
+#include "../HAL/MONITOR/MONITOR.h"
+#include "../HAL/RTC/RTC.h"
+#include "../HAL/PROTOCOL/PROTOCOL.h"
+#include "../HAL/FAILSAFE/FAILSAFE.h"
+#include "../HAL/SSEG/SSEG.h"
+#include "../HAL/TONE/TONE.h"
+#include "../HAL/LCD/LCD.h"
+#include "../HAL/KEYPAD/KEYPAD.h"
 
 #include "app.h"
 #include "app_cfg.h"
 
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
-/*                        PRIVATE FUNCTIONS PROTOTYPES                          */
+/*                            MACRO LIKE FUNCTIONS                              */
 /*                                                                              */
 /*------------------------------------------------------------------------------*/
 
-static void APP_UpdateState(void);
-static void EXTI_Notify(void);
-static void APP_CarsGreenState(void);
-static void APP_CarsYellowState(void);
-static void APP_CarsRedState(void);
-static void APP_PedestrianInitState(void);
-static void APP_PedestrianGreenState(void);
-static void APP_PedestrianFinalState(void);
+/*!< A green with a waiting pedestrian is ended this time before the wait limit, 
+     to leave the time of the pedestrian's initial state */
+#define PED_SERVE_DEADLINE_MS   ( PED_MAX_WAIT_MS - STATE_TIME_MS )
+
+/*!< Worst case: call at the start of the pedestrian's final state, then a full 
+     minimum green and the pedestrian's initial state */
+_Static_assert(PED_MAX_WAIT_MS >= ((2UL * STATE_TIME_MS) + PEAK_MIN_GREEN_MS),
+               "PED_MAX_WAIT_MS can not be guaranteed, it must cover 2 * STATE_TIME_MS + PEAK_MIN_GREEN_MS");
+_Static_assert(PED_MAX_WAIT_MS >= ((2UL * STATE_TIME_MS) + OFF_PEAK_MIN_GREEN_MS),
+               "PED_MAX_WAIT_MS can not be guaranteed, it must cover 2 * STATE_TIME_MS + OFF_PEAK_MIN_GREEN_MS");
+
+_Static_assert((PEAK_MIN_GREEN_MS >= PLAN_MIN_GREEN_FLOOR_MS) && (OFF_PEAK_MIN_GREEN_MS >= PLAN_MIN_GREEN_FLOOR_MS),
+               "The MIN_GREEN_MS of a plan must be at least PLAN_MIN_GREEN_FLOOR_MS");
+_Static_assert((PEAK_PASSAGE_MS > 0UL) && (OFF_PEAK_PASSAGE_MS > 0UL), "The PASSAGE_MS of a plan must not be 0");
+
+/*!< Coordinated cycle: the cars' green can be shrunk by COORD_MAX_ADJUST_MS when 
+     a pedestrian is served, and the pedestrian's worst wait is then a cycle 
+     minus the pedestrian's final state, plus the correction */
+_Static_assert(COORD_OFFSET_MS < COORD_CYCLE_MS, "COORD_OFFSET_MS must be less than COORD_CYCLE_MS");
+_Static_assert(COORD_CYCLE_MS <= 2000000UL, "COORD_CYCLE_MS must be at most 2000 s, 2 cycles in us fit in 32 bits");
+_Static_assert(COORD_CYCLE_MS >= ((3UL * STATE_TIME_MS) + COORD_MAX_ADJUST_MS + PEAK_MIN_GREEN_MS),
+               "COORD_CYCLE_MS is too short for the pedestrian's states and PEAK_MIN_GREEN_MS");
+_Static_assert(COORD_CYCLE_MS >= ((3UL * STATE_TIME_MS) + COORD_MAX_ADJUST_MS + OFF_PEAK_MIN_GREEN_MS),
+               "COORD_CYCLE_MS is too short for the pedestrian's states and OFF_PEAK_MIN_GREEN_MS");
+_Static_assert(PED_MAX_WAIT_MS >= (COORD_CYCLE_MS - STATE_TIME_MS + COORD_MAX_ADJUST_MS),
+               "PED_MAX_WAIT_MS can not be guaranteed in coordination");
+
+/*!< Transit priority shortens the pedestrian's and the cars' red states only */
+_Static_assert(TSP_MIN_WALK_MS <= STATE_TIME_MS, "TSP_MIN_WALK_MS must be at most STATE_TIME_MS");
+_Static_assert(TSP_MIN_RED_MS <= STATE_TIME_MS, "TSP_MIN_RED_MS must be at most STATE_TIME_MS");
+
+/*!< Adaptive cycle: the cycle covers at least the lost time, the window holds
+     the cycles of an update */
+_Static_assert((ADAPT_UPDATE_CYCLES >= 1U) && (ADAPT_UPDATE_CYCLES <= ADAPT_WINDOW_CYCLES),
+               "ADAPT_UPDATE_CYCLES must be 1 to ADAPT_WINDOW_CYCLES");
+_Static_assert(ADAPT_WINDOW_CYCLES <= 32U, "ADAPT_WINDOW_CYCLES must be at most 32");
+_Static_assert(ADAPT_MAX_FLOW_RATIO < 4096U, "ADAPT_MAX_FLOW_RATIO must be less than 4096, a flow ratio of 1");
+_Static_assert(ADAPT_MIN_CYCLE_MS >= (3UL * STATE_TIME_MS), "ADAPT_MIN_CYCLE_MS must cover the pedestrian's states");
+_Static_assert(ADAPT_MIN_CYCLE_MS <= ADAPT_MAX_CYCLE_MS, "ADAPT_MIN_CYCLE_MS must be at most ADAPT_MAX_CYCLE_MS");
+
+/*!< Fixed point of the adaptive cycle: the ratios are in 1/4096 */
+#define ADAPT_Q                 (12U)
+#define ADAPT_ONE               (1UL << ADAPT_Q)
 
+/*!< Histogram of the waits: one bin per PED_WAIT_BIN_MS, the last one for longer waits */
+#define PED_WAIT_BINS           ( (PED_MAX_WAIT_MS / PED_WAIT_BIN_MS) + 2UL )
+
+/*!< Time of day of the restart copy when the clock was not set: more than a day */
+#define APP_NO_TIME             (0xFFFFFFFFUL)
+#define APP_MS_PER_DAY          (86400000UL)
+
+/*!< CRC-16/CCITT of the restart copy and of the plans in the EEPROM */
+#define APP_CRC_POLYNOMIAL      (0x1021U)
+#define APP_CRC_INITIAL         (0xFFFFU)
+
+/*!< The CRC covers the fields before it */
+#define APP_RESTART_CRC()       APP_GetCrc(&appRestart, sizeof(appRestart) - sizeof(appRestart.crc))
+#define APP_RECORD_CRC(record)  APP_GetCrc(&(record), sizeof(record) - sizeof((record).crc))
 
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
@@ -80,19 +200,285 @@ typedef enum {
     APP_STATE_PEDESTRIAN_GREEN_STATE,
     APP_STATE_PEDESTRIAN_FINAL_STATE,
 
+    APP_STATE_FLASH,
+
+    APP_STATE_PREEMPT_CLEAR,
+    APP_STATE_PREEMPT_GREEN,
+
 } APP_STATE_t;
 
+/*********************************************************************************
+ * @brief Times of a timing plan, see app_cfg.h
+ ********************************************************************************/
+typedef struct {
+    u32_t   minGreenMs;
+    u32_t   passageMs;
+    u32_t   maxGreenMs;
+    BOOL_t  isFlash;
+} APP_PLAN_t;
+
+/*********************************************************************************
+ * @brief Times of a plan kept in the EEPROM, see \ref APP_LoadPlans
+ ********************************************************************************/
+typedef struct {
+    u32_t   minGreenMs;
+    u32_t   passageMs;
+    u32_t   maxGreenMs;
+    u16_t   crc;
+} APP_PLAN_RECORD_t;
+
+/*********************************************************************************
+ * @brief Demand of one cycle, kept in the window of the adaptive cycle, see 
+ *        \ref APP_Adapt
+ ********************************************************************************/
+typedef struct {
+    u32_t   cycleMs;
+    u32_t   occupiedMs;
+    u16_t   vehicles;
+    BOOL_t  isPedServed;
+} APP_CYCLE_SAMPLE_t;
+
+/*********************************************************************************
+ * @brief Copy of the state kept across a reset, see \ref APP_Resume. The times 
+ *        are ticks of the last run, the CRC covers all the fields before it
+ ********************************************************************************/
+typedef struct {
+    APP_STATE_t state;
+    u8_t        plan;
+    u8_t        lamps;
+    BOOL_t      isPedCalled;
+    BOOL_t      isCarsCalled;
+    u8_t        restarts;
+    u32_t       stateStartMs;
+    u32_t       pedCallMs;
+    u16_t       crc;
+} APP_RESTART_t;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                        PRIVATE FUNCTIONS PROTOTYPES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+static void APP_UpdateState(void);
+static void EXTI_Notify(void);
+static void APP_SyncNotify(void);
+static void APP_PreemptNotify(void);
+static void APP_CarsGreenState(void);
+static void APP_CarsYellowState(void);
+static void APP_CarsRedState(void);
+static void APP_PedestrianInitState(void);
+static void APP_PedestrianGreenState(void);
+static void APP_PedestrianFinalState(void);
+static void APP_FlashState(void);
+static void APP_PreemptClearState(void);
+static void APP_PreemptGreenState(void);
+static void APP_ShowCountdown(void);
+static void APP_PlayTone(void);
+static void APP_ShowStatus(void);
+static void APP_FormatTwoDigits(char * const pText, const u8_t value);
+
+static void APP_ChangeState(const APP_STATE_t nextState);
+static void APP_SetLamps(const u8_t image);
+static void APP_ToggleLamp(const LED_t led);
+static BOOL_t APP_Resume(void);
+static void APP_SaveRestart(void);
+static u16_t APP_GetCrc(const void * const pData, const u8_t length);
+static void APP_LogReset(void);
+static u32_t APP_GetStateTimeMs(void);
+static BOOL_t APP_IsBlinkTime(void);
+static void APP_ReadCarsDetector(void);
+static void APP_ReadPedestrianButton(void);
+static void APP_ReadKeypad(void);
+static void APP_ReadPreempt(void);
+static void APP_CallTransit(void);
+static BOOL_t APP_ExtendGreen(void);
+static BOOL_t APP_IsEarlyGreen(const u32_t stateMs);
+static void APP_ServeTransit(void);
+static void APP_Preempt(void);
+static void APP_TimePreempt(void);
+static void APP_TimeLoop(void);
+static void APP_ServePedestrianCall(void);
+static void APP_ApplyPlan(void);
+static void APP_EndCycle(void);
+static void APP_ReadSync(void);
+static void APP_MeasurePhase(void);
+static void APP_Adapt(void);
+static void APP_UpdateCycle(void);
+static u32_t APP_GetMaxGreenMs(void);
+static void APP_HandleCommand(const u8_t type, const u8_t * const pPayload, const u8_t length);
+static ERROR_t APP_SetPlan(const u8_t * const pPayload, const u8_t length);
+static ERROR_t APP_CheckPlan(const u32_t minGreenMs, const u32_t passageMs, const u32_t maxGreenMs);
+static void APP_StagePlans(void);
+static void APP_LoadPlans(void);
+static ERROR_t APP_SavePlans(void);
+static u32_t APP_GetU32(const u8_t * const pBytes);
+
+
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
 /*                           PRIVATE GLOBALS VARIABLES                          */
 /*                                                                              */
 /*------------------------------------------------------------------------------*/
 
+/*!< Two sets of plans, indexed by the plans of the schedule: the active one, 
+     and the staged one written over the command link or from the EEPROM. The
+     staged set is only valid while isPlanStaged is TRUE, see \ref APP_StagePlans */
+static APP_PLAN_t appPlanSets[2][NUM_OF_RTC_PLANS] = {
+    {
+        [RTC_PLAN_PEAK]         = {PEAK_MIN_GREEN_MS, PEAK_PASSAGE_MS, PEAK_MAX_GREEN_MS, FALSE},
+        [RTC_PLAN_OFF_PEAK]     = {OFF_PEAK_MIN_GREEN_MS, OFF_PEAK_PASSAGE_MS, OFF_PEAK_MAX_GREEN_MS, FALSE},
+        [RTC_PLAN_NIGHT_FLASH]  = {0, 0, 0, TRUE},
+    },
+};
+static APP_PLAN_t * appPlans = appPlanSets[0];
+static APP_PLAN_t * appStagedPlans = appPlanSets[1];
+
+/*!< TRUE when the staged set differs from the active one, it is swapped in at 
+     the next cycle boundary, see \ref APP_ApplyPlan */
+static BOOL_t isPlanStaged = FALSE;
+
+/*!< The plan of the current cycle                  */
+static const APP_PLAN_t * appPlan = &appPlanSets[0][RTC_PLAN_PEAK];
+
+/*!< The plan forced from the keypad, NUM_OF_RTC_PLANS to follow the schedule */
+static RTC_PLAN_t appManualPlan = NUM_OF_RTC_PLANS;
+
 /*!< The current state of the system                */
 static APP_STATE_t appState = APP_STATE_INIT;
 
-/*!< The current state of the pedestrian button     */
-static BOOL_t isButtonPressed = FALSE;
+/*!< TRUE on the first update of a new state, to set its lights */
+static BOOL_t isStateEntry = FALSE;
+
+/*!< Set by the button ISR, latched as a call by the state machine */
+static volatile BOOL_t isButtonPressed = FALSE;
+
+/*!< Pending pedestrian call, and tick of the first press not served yet */
+static BOOL_t isPedCalled = FALSE;
+static u32_t appPedCallMs = 0;
+
+/*!< Served pedestrian calls: histogram of their wait, their number and the longest wait */
+static u16_t appPedWaitHistogram[PED_WAIT_BINS];
+static u16_t appPedServed = 0;
+static u32_t appPedMaxWaitMs = 0;
+
+/*!< Tick of the current update, the start of the current state and the last blink */
+static u32_t appNowMs = 0;
+static u32_t appStateStartMs = 0;
+static u32_t appBlinkMs = 0;
+
+/*!< Corridor sync: time of the last pulse, written by the EXTI_1 ISR, and tick 
+     of the update that saw it */
+static volatile u32_t appSyncUs = 0;
+static volatile BOOL_t isSyncPending = FALSE;
+static volatile BOOL_t isSyncReceived = FALSE;
+static u32_t appSyncMs = 0;
+
+/*!< Coordination of the current cycle: phase error at its start, and the time
+     the green is shrunk by to correct it */
+static BOOL_t isCoordinated = FALSE;
+static s32_t appPhaseErrorUs = 0;
+static s32_t appGreenAdjustMs = 0;
+
+/*!< Adaptive cycle: the window of the last cycles and its sums, the start of
+     the current cycle with the counts at its start, and the last result */
+static APP_CYCLE_SAMPLE_t appCycles[ADAPT_WINDOW_CYCLES];
+static u8_t appCycleIndex = 0;
+static u8_t appCyclesKept = 0;
+static u8_t appCyclesToUpdate = ADAPT_UPDATE_CYCLES;
+static u32_t appWindowMs = 0;
+static u32_t appWindowOccupiedMs = 0;
+static u32_t appWindowVehicles = 0;
+static u8_t appWindowPedCycles = 0;
+
+static BOOL_t isCycleStarted = FALSE;
+static u32_t appCycleStartMs = 0;
+static u32_t appCycleCarsCount = 0;
+static u32_t appCycleOccupiedMs = 0;
+static BOOL_t isCyclePedServed = FALSE;
+
+static BOOL_t isAdaptive = FALSE;
+static u32_t appAdaptCycleMs = 0;
+static u32_t appAdaptGreenMs = 0;
+
+/*!< Transit priority: pending call and its tick, tick the green would have 
+     ended at without it, delay saved so far, and greens left without priority */
+static BOOL_t isTransitCalled = FALSE;
+static u32_t appTransitCallMs = 0;
+static BOOL_t isTransitExtending = FALSE;
+static u32_t appTransitEndMs = 0;
+static u32_t appTransitSavedMs = 0;
+static u8_t appTransitLockout = 0;
+
+/*!< Preemption: time of the last edge, written by the EXTI_2 ISR, and its copy
+     taken by the loop */
+static volatile u32_t appPreemptUs = 0;
+static volatile BOOL_t isPreemptPending = FALSE;
+static u32_t appPreemptEdgeUs = 0;
+
+/*!< Preemption call, until the end of the preempted green, and level of the 
+     input, held low by the receiver while the vehicle comes */
+static BOOL_t isPreemptCalled = FALSE;
+static BOOL_t isPreemptHeld = FALSE;
+
+/*!< Calls since reset, and the latency from the edge to the first lamp write 
+     of the transition: TRUE until the update that takes the call is timed */
+static u16_t appPreempts = 0;
+static BOOL_t isPreemptTiming = FALSE;
+static BOOL_t isPreemptTimed = FALSE;
+static u32_t appPreemptMaxLatencyUs = 0;
+
+/*!< Period of the control loop: the time of the last update, and the longest 
+     time between two updates since reset */
+static u32_t appLoopUs = 0;
+static BOOL_t isLoopTimed = FALSE;
+static u32_t appLoopMaxUs = 0;
+
+/*!< Periods of the loop, and latencies of the preemption, over PREEMPT_MAX_LATENCY_US */
+static u16_t appLoopOverruns = 0;
+static u16_t appPreemptOverruns = 0;
+
+/*!< Cars' detector: last count read, tick of the last vehicle, and pending call */
+static u32_t appCarsCount = 0;
+static u32_t appLastActuationMs = 0;
+static BOOL_t isCarsCalled = CARS_RECALL;
+
+/*!< The lamps set by the state functions, one LED_BIT per lit lamp */
+static u8_t appLamps = 0;
+
+/*!< Not cleared by the startup code: the copy of the state, written when it 
+     changes, and the tick and the time of day of the last update with their 
+     complements, written on every update out of the CRC */
+static APP_RESTART_t appRestart __attribute__((section(".noinit")));
+static u32_t appRestartNowMs __attribute__((section(".noinit")));
+static u32_t appRestartNowCheck __attribute__((section(".noinit")));
+static u32_t appRestartDayMs __attribute__((section(".noinit")));
+static u32_t appRestartDayCheck __attribute__((section(".noinit")));
+
+/*!< Time of day of the last run to restore, APP_NO_TIME if it was not set */
+static u32_t appResumeDayMs = APP_NO_TIME;
+
+/*!< Warm restarts since the last cycle end, and TRUE if this run was resumed */
+static u8_t appRestarts = 0;
+static BOOL_t isResumed = FALSE;
+
+/*!< Status panel: the names of the states and of the plans, padded to their 
+     field, and the state and tick of the last refresh */
+static const char * const appStateNames[] = {
+    "INIT        ",
+    "CARS GREEN  ",
+    "CARS YELLOW ",
+    "CARS RED    ",
+    "PED CALL    ",
+    "PED WALK    ",
+    "PED CLEAR   ",
+    "FLASH       ",
+    "PREEMPT CLR ",
+    "PREEMPT GRN ",
+};
+static const char * const appPlanNames[NUM_OF_RTC_PLANS] = {"PEAK", "OFFP", "NGHT"};
+static APP_STATE_t appShownState = APP_STATE_INIT;
+static u32_t appShownMs = 0;
 
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
@@ -103,12 +489,53 @@ static BOOL_t isButtonPressed = FALSE;
 void APP_Init(void) {
     appState = APP_STATE_INIT;
 
+    /* The lamps are taken back first: the slow drivers come after */
     DIO_Init();
-    EXTI_Init(EXTI_0, FALLING_EDGE, EXTI_Notify);
+    FAILSAFE_Init();
     LED_Init();
+
+    isResumed = APP_Resume();
+    APP_SaveRestart();
+
+    UART_Init();
+    TWI_Init();
+    ADC_Init();
+    EEPROM_Init();
+    /* Before the first counter add: a running write makes the reads busy */
+    APP_LoadPlans();
+    APP_LogReset();
+    EXTI_Init(EXTI_0, FALLING_EDGE, EXTI_Notify);
     BUTTON_Init();
+    COUNTER_Init();
+    SPEED_Init();
+    SSEG_Init();
+    TIMER_TickInit();
+    TONE_Init();
+    LCD_Init();
+    KEYPAD_Init();
+    RTC_Init();
+    if(appResumeDayMs < APP_MS_PER_DAY) {
+        /* The time of day is advanced by the startup, not by the reset itself */
+        RTC_SetMsOfDay((appResumeDayMs + TIMER_GetTickMs()) % APP_MS_PER_DAY);
+    }
+    PROTOCOL_Init(APP_HandleCommand);
+    WDT_Init();
+    MONITOR_Init();
+    LED_StartLampCheck();
+
+    COUNTER_Read(COUNTER_CARS, &appCarsCount);
 
     EXTI_EnableExternalInterrupt(EXTI_0);
+
+    if(COORD_ENABLE) {
+        EXTI_Init(EXTI_1, FALLING_EDGE, APP_SyncNotify);
+        EXTI_EnableExternalInterrupt(EXTI_1);
+    }
+
+    if(PREEMPT_ENABLE) {
+        EXTI_Init(EXTI_2, FALLING_EDGE, APP_PreemptNotify);
+        EXTI_EnableExternalInterrupt(EXTI_2);
+    }
 }
 
 void APP_Start(void) {
@@ -121,7 +548,93 @@ void APP_Start(void) {
 	return;
 }
 
+ERROR_t APP_GetPedestrianWaitPercentile(const u8_t percentile, u32_t * const pWaitMs) {
+    u32_t u32Rank = 0;
+    u32_t u32Count = 0;
+    u8_t u8Bin = 0;
+
+    if(NULL == pWaitMs) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if( (0 == percentile) || (percentile > 100) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    if(0 == appPedServed) {
+        return ERROR_NOK;
+    }
+
+    if(100 == percentile) {
+        *pWaitMs = appPedMaxWaitMs;
+        return ERROR_OK;
+    }
+
+    /* Nearest rank: the smallest wait covering percentile % of the calls */
+    u32Rank = (((u32_t)percentile * appPedServed) + 99UL) / 100UL;
+
+    for(u8Bin = 0; u8Bin < (PED_WAIT_BINS - 1UL); u8Bin++) {
+        u32Count += appPedWaitHistogram[u8Bin];
+
+        if(u32Count >= u32Rank) {
+            break;
+        }
+    }
+
+    /* Upper edge of the bin, never above the longest wait seen */
+    *pWaitMs = (u32_t)(u8Bin + 1U) * PED_WAIT_BIN_MS;
+
+    if(*pWaitMs > appPedMaxWaitMs) {
+        *pWaitMs = appPedMaxWaitMs;
+    }
+
+    return ERROR_OK;
+}
+
+
+
+ERROR_t APP_GetAdaptiveCycle(u32_t * const pCycleMs, u32_t * const pGreenMs) {
+    if( (NULL == pCycleMs) || (NULL == pGreenMs) ) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(!isAdaptive) {
+        return ERROR_NOK;
+    }
+
+    *pCycleMs = appAdaptCycleMs;
+    *pGreenMs = appAdaptGreenMs;
+
+    return ERROR_OK;
+}
+
+ERROR_t APP_GetPreemptLatencyUs(u32_t * const pLatencyUs) {
+    if(NULL == pLatencyUs) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(!isPreemptTimed) {
+        return ERROR_NOK;
+    }
+
+    *pLatencyUs = appPreemptMaxLatencyUs;
+
+    return ERROR_OK;
+}
+
+ERROR_t APP_GetPhaseErrorUs(s32_t * const pErrorUs) {
+    if(NULL == pErrorUs) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(!isCoordinated) {
+        return ERROR_NOK;
+    }
+
+    *pErrorUs = appPhaseErrorUs;
 
+    return ERROR_OK;
+}
 
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
@@ -131,268 +644,1758 @@ void APP_Start(void) {
 
 /*********************************************************************************
  * @brief   Update the application state
- * @details Update the application state by checking the current state and
- *          calling the corresponding function, then change the state to the next
- *          state
+ * @details Read the tick, the inputs and the command link, then call the 
+ *          function of the current state. Each pass checks in with the 
+ *          watchdog. The state functions return immediately, they change the
+ *          state by \ref APP_ChangeState when their time is over
  * @param   void
  * @return  void
  ********************************************************************************/
 static void APP_UpdateState(void) {
+    appNowMs = TIMER_GetTickMs();
+    WDT_CheckIn(WDT_ACTIVITY_CONTROL_LOOP);
+    APP_TimeLoop();
+
+    APP_ReadCarsDetector();
+    APP_ReadPedestrianButton();
+    APP_ReadKeypad();
+    APP_ReadSync();
+    APP_ReadPreempt();
+
+    PROTOCOL_Update();
+    LCD_Update();
+    KEYPAD_Update();
+
+    if(isPreemptCalled) {
+        APP_Preempt();
+    }
+
     switch(appState) {
         case APP_STATE_INIT:
-            appState = APP_STATE_CARS_GREEN;
+            APP_ApplyPlan();
+            APP_ChangeState(appPlan->isFlash ? APP_STATE_FLASH : APP_STATE_CARS_GREEN);
             break;
         case APP_STATE_CARS_GREEN:
-            appState = APP_STATE_CARS_YELLOW;
             APP_CarsGreenState();
             break;
         case APP_STATE_CARS_YELLOW:
-            appState = APP_STATE_CARS_RED;
             APP_CarsYellowState();
             break;
         case APP_STATE_CARS_RED:
-            appState = APP_STATE_CARS_GREEN;
             APP_CarsRedState();
             break;
         case APP_STATE_PEDESTRIAN_INIT_STATE:
-            appState = APP_STATE_PEDESTRIAN_GREEN_STATE;
             APP_PedestrianInitState();
             break;
         case APP_STATE_PEDESTRIAN_GREEN_STATE:
-            appState = APP_STATE_PEDESTRIAN_FINAL_STATE;
             APP_PedestrianGreenState();
             break;
         case APP_STATE_PEDESTRIAN_FINAL_STATE:
-            appState = APP_STATE_CARS_GREEN;
             APP_PedestrianFinalState();
             break;
+        case APP_STATE_FLASH:
+            APP_FlashState();
+            break;
+        case APP_STATE_PREEMPT_CLEAR:
+            APP_PreemptClearState();
+            break;
+        case APP_STATE_PREEMPT_GREEN:
+            APP_PreemptGreenState();
+            break;
         default:
             break;
     }
+
+    APP_TimePreempt();
+
+    APP_ShowCountdown();
+    APP_PlayTone();
+    APP_ShowStatus();
+    APP_SaveRestart();
 }
 
 /*********************************************************************************
- * @brief   Notify the application that the button is pressed
- * @details This is a callback used by the EXTI deiver to notify the application 
- *          that the button is pressed by setting the isButtonPressed flag to TRUE
+ * @brief   Show the pedestrians the seconds left
+ * @details The seconds to the walk in the pedestrian's initial state, of the 
+ *          walk in its green state, and of the clearance in its final state,
+ *          rounded up. The display is blank in the other states. The display
+ *          is only written when the seconds change
  * @param   void
  * @return  void
  ********************************************************************************/
-static void EXTI_Notify(void) {
-    isButtonPressed = TRUE;
+static void APP_ShowCountdown(void) {
+    u32_t u32StateMs = APP_GetStateTimeMs();
+
+    switch(appState) {
+        case APP_STATE_PEDESTRIAN_INIT_STATE:
+        case APP_STATE_PEDESTRIAN_GREEN_STATE:
+        case APP_STATE_PEDESTRIAN_FINAL_STATE:
+            if(u32StateMs < STATE_TIME_MS) {
+                SSEG_SetNumber((u16_t)((STATE_TIME_MS - u32StateMs + 999UL) / 1000UL));
+            } else {
+                SSEG_SetNumber(0);
+            }
+            break;
+        default:
+            SSEG_Clear();
+            break;
+    }
 }
 
 /*********************************************************************************
- * @brief   Cars' green state
- * @details This function is called when the system is in cars' green state, it
- *          will turn on the cars' green light and pedestrian's red ligh, and 
- *          turn off the other lights
- *          Then it will wait for 5 seconds, and if the button is pressed, it will
- *          change the state to pedestrian's init state
+ * @brief   Sound the accessible pedestrian signal
+ * @details The walk tone during the pedestrian's green, silent in the night 
+ *          flash where the calls are dropped, the locator tone otherwise. The
+ *          tone restarts only when it changes
  * @param   void
  * @return  void
  ********************************************************************************/
-static void APP_CarsGreenState(void) {
-    /* Configure the pedestrians' light */
-    LED_Set(LED_PEDESTRIAN_R);
-    LED_Clr(LED_PEDESTRIAN_G);
-    LED_Clr(LED_PEDESTRIAN_Y);
-    
-    /* Configure the cars' light */
-    LED_Set(LED_CAR_G);
-    LED_Clr(LED_CAR_Y);
-    LED_Clr(LED_CAR_R);
-
-    /* Waiting for the button to be pressed. 
-        If the button is pressed, it will go to the next state. 
-        If the button is not pressed, it will wait for the next second. 
-    */
-    for(u8_t i = 0; i < STATE_TIME_SEC; i++) {
-        if(isButtonPressed) {
-            isButtonPressed = FALSE;
-            appState = APP_STATE_PEDESTRIAN_INIT_STATE;
-            return;
-        }
-
-        TIMER_DelayMs(1000);
+static void APP_PlayTone(void) {
+    switch(appState) {
+        case APP_STATE_PEDESTRIAN_GREEN_STATE:
+            TONE_Play(TONE_WALK);
+            break;
+        case APP_STATE_FLASH:
+            TONE_Play(TONE_NONE);
+            break;
+        default:
+            TONE_Play(TONE_LOCATOR);
+            break;
     }
 }
 
 /*********************************************************************************
- * @brief   Cars' yellow state
- * @details This function is called when the system is in cars' yellow state, it
- *          will blink the cars' yellow light and turn on the pedestrian's red ligh, 
- *          and turn off the other lights
- *          Then it will wait for 5 seconds, and if the button is pressed, it will
- *          change the state to pedestrian's initial state
+ * @brief   Refresh the status panel
+ * @details On a change of state, or every STATUS_REFRESH_MS for the clock. 
+ *          Only the shadow of the LCD is written, \ref LCD_Update sends the 
+ *          characters that changed. The texts fit a screen of 2 x 16:
+ *              | CARS GREEN  PEAK |
+ *              | 12:34:56 FAULT   |
+ *          FAULT when a lamp was found dark, see \ref LED_IsLampFault
  * @param   void
  * @return  void
  ********************************************************************************/
-static void APP_CarsYellowState(void) {
-    /* Configure the pedestrians' light */
-    LED_Set(LED_PEDESTRIAN_R);
-    LED_Clr(LED_PEDESTRIAN_G);
-    LED_Clr(LED_PEDESTRIAN_Y);
-
-    /* Configure the cars' light */
-    LED_Set(LED_CAR_Y);
-    LED_Set(LED_CAR_G);
-    LED_Clr(LED_CAR_R);
-
-    /* Waiting for the button to be pressed, while blinking the yellow light.
-        If the button is pressed, it will go to the next state. 
-        If the button is not pressed, it will wait for the next second. 
-    */
-    for(u8_t i = 0; i < STATE_TIME_SEC; i++) {
-        if(isButtonPressed) {
-            isButtonPressed = FALSE;
-            appState = APP_STATE_PEDESTRIAN_INIT_STATE;
-            return;
+static void APP_ShowStatus(void) {
+    char acTime[] = "--:--:-- ";
+    RTC_TIME_t time;
+    BOOL_t isFault = FALSE;
+    u8_t i = 0;
+
+    if( (appState == appShownState) && ((appNowMs - appShownMs) < STATUS_REFRESH_MS) ) {
+        return;
+    }
+
+    appShownState = appState;
+    appShownMs = appNowMs;
+
+    if(appState < (sizeof(appStateNames) / sizeof(appStateNames[0]))) {
+        LCD_Write(0, 0, appStateNames[appState]);
+    }
+
+    LCD_Write(0, 12, appPlanNames[appPlan - appPlans]);
+
+    if(ERROR_OK == RTC_GetTime(&time)) {
+        APP_FormatTwoDigits(&acTime[0], time.hours);
+        APP_FormatTwoDigits(&acTime[3], time.minutes);
+        APP_FormatTwoDigits(&acTime[6], time.seconds);
+    }
+
+    LCD_Write(1, 0, acTime);
+
+    for(i = 0; i < NUM_OF_LEDS; ++i) {
+        if(LED_IsLampFault((LED_t)i)) {
+            isFault = TRUE;
         }
+    }
+
+    LCD_Write(1, 9, isFault ? "FAULT  " : "       ");
+}
+
+/*********************************************************************************
+ * @brief   Write a number of 0 to 99 as two digits
+ * @param   pText: the two characters
+ * @param   value: the number
+ * @return  void
+ ********************************************************************************/
+static void APP_FormatTwoDigits(char * const pText, const u8_t value) {
+    pText[0] = (char)('0' + ((value / 10U) % 10U));
+    pText[1] = (char)('0' + (value % 10U));
+}
+
+/*********************************************************************************
+ * @brief   Go to a new state
+ * @details Restart the state and blink timers, the lights are set by the state 
+ *          function on its next update
+ * @param   nextState: the new state
+ * @return  void
+ ********************************************************************************/
+static void APP_ChangeState(const APP_STATE_t nextState) {
+    appState = nextState;
+    appStateStartMs = appNowMs;
+    appBlinkMs = appNowMs;
+    isStateEntry = TRUE;
+}
 
-        TIMER_DelayMs(1000);
+/*********************************************************************************
+ * @brief   Set the lamps of the state
+ * @details The failsafe takes over if the lamps are not set, see 
+ *          \ref FAILSAFE_Enter
+ * @param   image: one LED_BIT per lit lamp
+ * @return  void
+ ********************************************************************************/
+static void APP_SetLamps(const u8_t image) {
+    appLamps = image;
 
-        LED_Toggle(LED_CAR_Y);
+    if(ERROR_OK != LED_SetImage(image)) {
+        FAILSAFE_Enter();
     }
 }
 
 /*********************************************************************************
- * @brief   Cars' red state
- * @details This function is called when the system is in cars' red state, it
- *          will turn on the cars' red light and pedestrian's red ligh, and 
- *          turn off the other lights
- *          Then it will wait for 5 seconds, and if the button is pressed, it will
- *          change the state to pedestrian's green state   
- * 
- * @param   void
+ * @brief   Toggle a blinking lamp
+ * @details The failsafe takes over if the lamp is not toggled, see 
+ *          \ref FAILSAFE_Enter
+ * @param   led: the lamp
  * @return  void
  ********************************************************************************/
-static void APP_CarsRedState(void) {
-    /* Configure the pedestrians' light */
-    LED_Set(LED_PEDESTRIAN_R);
-    LED_Clr(LED_PEDESTRIAN_G);
-    LED_Clr(LED_PEDESTRIAN_Y);
-    
-    /* Configure the cars' light */
-    LED_Set(LED_CAR_R);
-    LED_Clr(LED_CAR_G);
-    LED_Clr(LED_CAR_Y);
-
-    /* Waiting for the button to be pressed. 
-        If the button is pressed, it will go to the next state. 
-        If the button is not pressed, it will wait for the next second. 
-    */
-    for(u8_t i = 0; i < STATE_TIME_SEC; i++) {
-        if(isButtonPressed) {
-            isButtonPressed = FALSE;
-            appState = APP_STATE_PEDESTRIAN_GREEN_STATE;
-            return;
-        }
+static void APP_ToggleLamp(const LED_t led) {
+    appLamps ^= LED_BIT(led);
 
-        TIMER_DelayMs(1000);
+    if(ERROR_OK != LED_Toggle(led)) {
+        FAILSAFE_Enter();
     }
 }
 
 /*********************************************************************************
- * @brief   Pedestrian's initial state
- * @details This function is called when the system is in pedestrian's initial state, 
- *          it will turn on the cars' green light and blink both car's yeallo and 
- *          pedestrian's yellow lights, and turn off the other lights
- *          Then it will wait for 5 seconds, and change the state to pedestrian's 
- *          green state. If the button is pressed, it has no effect
+ * @brief   Resume the state of the run before the reset
+ * @details Only after a watchdog or brown-out reset: RAM is random after a
+ *          power on, and the RESET pin is a request for a new cycle. The copy
+ *          is taken if its CRC and its tick are right, and if the state was
+ *          not resumed WARM_RESTART_MAX times in a row. The elapsed times are 
+ *          moved to the new tick, and the lamps are set as they were, 
+ *          blinking lamps included. The time of day is restored after 
+ *          RTC_Init, so the schedule keeps its plan. The time spent in reset 
+ *          is not counted.
+ *          Called from APP_Init, before the slow drivers: with the early init
+ *          of the DIO, the reds are shown for the startup code and DIO_Init 
+ *          only
  * @param   void
- * @return  void
+ * @return  BOOL_t: TRUE if the state was resumed
  ********************************************************************************/
-static void APP_PedestrianInitState(void) {
-    /* Configure the pedestrians' light */
-    LED_Clr(LED_PEDESTRIAN_G);
-    LED_Clr(LED_PEDESTRIAN_R);
-    LED_Set(LED_PEDESTRIAN_Y);
+static BOOL_t APP_Resume(void) {
+    WDT_RESET_t source = WDT_GetResetSource();
 
-    /* Configure the cars' light */
-    LED_Clr(LED_CAR_R);
-    LED_Set(LED_CAR_G);
-    LED_Set(LED_CAR_Y);  
+    if( !WARM_RESTART_ENABLE || 
+        ((WDT_RESET_WATCHDOG != source) && (WDT_RESET_BROWN_OUT != source)) ) {
+        return FALSE;
+    }
 
-    /* Waiting for the next second, while blinking the yellow lights of
-        both cars and pedestrians.
-    */
-    for(u8_t i = 0; i < STATE_TIME_SEC; i++) {
-        TIMER_DelayMs(1000);
+    if( (APP_RESTART_CRC() != appRestart.crc) || 
+        (appRestartNowCheck != (u32_t)~appRestartNowMs) ) {
+        return FALSE;
+    }
 
-        LED_Toggle(LED_PEDESTRIAN_Y);
-        LED_Toggle(LED_CAR_Y);
+    if( (APP_STATE_INIT == appRestart.state) || (appRestart.state > APP_STATE_PREEMPT_GREEN) ||
+        (appRestart.plan >= NUM_OF_RTC_PLANS) || (appRestart.restarts >= WARM_RESTART_MAX) ) {
+        return FALSE;
     }
 
+    appNowMs = TIMER_GetTickMs();
 
-    if(isButtonPressed) {
-        isButtonPressed = FALSE;
+    appState = appRestart.state;
+    appPlan = &appPlans[appRestart.plan];
+    appStateStartMs = appNowMs - (appRestartNowMs - appRestart.stateStartMs);
+    appBlinkMs = appNowMs;
+    isStateEntry = FALSE;
+
+    isPedCalled = appRestart.isPedCalled;
+    appPedCallMs = appNowMs - (appRestartNowMs - appRestart.pedCallMs);
+    isCarsCalled = appRestart.isCarsCalled;
+
+    appRestarts = appRestart.restarts + 1U;
+
+    /* Without the time of day, the schedule would restart on RTC_UNSET_PLAN */
+    if(appRestartDayCheck == (u32_t)~appRestartDayMs) {
+        appResumeDayMs = appRestartDayMs;
     }
+
+    APP_SetLamps(appRestart.lamps);
+
+    return TRUE;
 }
 
 /*********************************************************************************
- * @brief   Pedestrian's green state
- * @details This function is called when the system is in pedestrian's green state, 
- *          it will turn on the cars' red light and pedestrian's green light, and 
- *          turn off the other lights
- *          Then it will wait for 5 seconds, and change the state to pedestrian's 
- *          final state. If the button is pressed, it has no effect
+ * @brief   Keep the state for a warm restart
+ * @details Called at the end of each update. The tick is written every time, 
+ *          the copy and its CRC only when the state changed: the cost of an 
+ *          update is a few compares
  * @param   void
  * @return  void
  ********************************************************************************/
-static void APP_PedestrianGreenState(void) {
-    /* Configure the pedestrians' light */
-    LED_Set(LED_PEDESTRIAN_G);
-    LED_Clr(LED_PEDESTRIAN_R);
-    LED_Clr(LED_PEDESTRIAN_Y);
+static void APP_SaveRestart(void) {
+    u8_t u8Plan = (u8_t)(appPlan - appPlans);
+    u32_t u32DayMs = APP_NO_TIME;
 
-    /* Configure the cars' light */
-    LED_Set(LED_CAR_R);
-    LED_Clr(LED_CAR_G);
-    LED_Clr(LED_CAR_Y);
+    appRestartNowMs = appNowMs;
+    appRestartNowCheck = ~appNowMs;
 
+    /* Until the clock is restored, the time to restore is kept */
+    if(ERROR_OK != RTC_GetMsOfDay(&u32DayMs)) {
+        u32DayMs = appResumeDayMs;
+    }
+    appRestartDayMs = u32DayMs;
+    appRestartDayCheck = ~u32DayMs;
 
-    TIMER_DelayMs(5000);
-    if(isButtonPressed) {
-        isButtonPressed = FALSE;
+    if( (appRestart.state == appState) && (appRestart.plan == u8Plan) && 
+        (appRestart.lamps == appLamps) && (appRestart.isPedCalled == isPedCalled) &&
+        (appRestart.isCarsCalled == isCarsCalled) && (appRestart.restarts == appRestarts) &&
+        (appRestart.stateStartMs == appStateStartMs) && (appRestart.pedCallMs == appPedCallMs) ) {
+        return;
     }
+
+    /* A reset while writing leaves a wrong CRC: the next start is cold */
+    appRestart.state = appState;
+    appRestart.plan = u8Plan;
+    appRestart.lamps = appLamps;
+    appRestart.isPedCalled = isPedCalled;
+    appRestart.isCarsCalled = isCarsCalled;
+    appRestart.restarts = appRestarts;
+    appRestart.stateStartMs = appStateStartMs;
+    appRestart.pedCallMs = appPedCallMs;
+    appRestart.crc = APP_RESTART_CRC();
 }
 
 /*********************************************************************************
- * @brief   Pedestrian's final state
- * @details This function is called when the system is in pedestrian's final state, 
- *          it will turn on the cars' red light and blink both car's yeallo and 
- *          pedestrian's yellow lights, and turn off the other lights
- *          Then it will wait for 5 seconds, and change the state to cars' green 
- *          state. 
- *          If the button is pressed, it has no effect
- * @param   void
- * @return  void
+ * @brief   CRC-16/CCITT of a block of RAM
+ * @param   pData: the first byte
+ * @param   length: the number of bytes
+ * @return  u16_t: the CRC
  ********************************************************************************/
-static void APP_PedestrianFinalState(void) {
-    /* Configure the pedestrians' light */
-    LED_Set(LED_PEDESTRIAN_G);
-    LED_Clr(LED_PEDESTRIAN_R);
-    LED_Set(LED_PEDESTRIAN_Y);
-
-    /* Configure the cars' light */
-    LED_Clr(LED_CAR_R);
-    LED_Clr(LED_CAR_G);
-    LED_Set(LED_CAR_Y);
+static u16_t APP_GetCrc(const void * const pData, const u8_t length) {
+    const u8_t * pBytes = (const u8_t *)pData;
+    u16_t u16Crc = APP_CRC_INITIAL;
+    u8_t i = 0;
+    u8_t j = 0;
 
-    /* Waiting for the next second, while blinking the yellow lights of
-        both cars and pedestrians.
-    */
-    for(u8_t i = 0; i < STATE_TIME_SEC; i++) {        
-        TIMER_DelayMs(1000);
+    for(i = 0; i < length; i++) {
+        u16Crc ^= (u16_t)pBytes[i] << 8;
 
-        LED_Toggle(LED_PEDESTRIAN_Y);
-        LED_Toggle(LED_CAR_Y);
+        for(j = 0; j < 8U; j++) {
+            if(u16Crc & 0x8000U) {
+                u16Crc = (u16_t)(u16Crc << 1) ^ APP_CRC_POLYNOMIAL;
+            } else {
+                u16Crc = (u16_t)(u16Crc << 1);
+            }
+        }
     }
 
+    return u16Crc;
+}
 
-    if(isButtonPressed) {
-        isButtonPressed = FALSE;
+/*********************************************************************************
+ * @brief   Count the resets by the watchdog and the brown-out detector
+ * @details The source is taken from MCUCSR by the WDT, see 
+ *          \ref WDT_GetResetSource. The counts are kept in the EEPROM
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_LogReset(void) {
+    switch(WDT_GetResetSource()) {
+        case WDT_RESET_WATCHDOG:
+            EEPROM_CounterAdd(EEPROM_COUNTER_WATCHDOG_RESETS, 1);
+            break;
+        case WDT_RESET_BROWN_OUT:
+            EEPROM_CounterAdd(EEPROM_COUNTER_BROWN_OUT_RESETS, 1);
+            break;
+        default:
+            break;
     }
 }
 
+/*********************************************************************************
+ * @brief   Time spent in the current state
+ * @param   void
+ * @return  u32_t: time in milliseconds
+ ********************************************************************************/
+static u32_t APP_GetStateTimeMs(void) {
+    return appNowMs - appStateStartMs;
+}
+
+/*********************************************************************************
+ * @brief   Check if the yellow lights have to be toggled
+ * @param   void
+ * @return  BOOL_t: TRUE once every BLINK_TIME_MS
+ ********************************************************************************/
+static BOOL_t APP_IsBlinkTime(void) {
+    if( (appNowMs - appBlinkMs) >= BLINK_TIME_MS ) {
+        appBlinkMs += BLINK_TIME_MS;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/*********************************************************************************
+ * @brief   Track the actuations of the cars' detector
+ * @details Any new pulse of the detector places a call for the cars' green and 
+ *          restarts the passage time. Each successful read checks in the 
+ *          inputs with the watchdog
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_ReadCarsDetector(void) {
+    u32_t u32Count = 0;
+
+    if(ERROR_OK != COUNTER_Read(COUNTER_CARS, &u32Count)) {
+        return;
+    }
+
+    /* The count of the detector is fresh */
+    WDT_CheckIn(WDT_ACTIVITY_INPUTS);
+
+    if(u32Count != appCarsCount) {
+        appCarsCount = u32Count;
+        appLastActuationMs = appNowMs;
+        isCarsCalled = TRUE;
+    }
+}
+
+/*********************************************************************************
+ * @brief   Latch the presses of the pedestrian button
+ * @details A press places a pedestrian call. Presses while a call is pending
+ *          keep the time of the first one
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_ReadPedestrianButton(void) {
+    if(isButtonPressed) {
+        isButtonPressed = FALSE;
+
+        if(!isPedCalled) {
+            isPedCalled = TRUE;
+            appPedCallMs = appNowMs;
+        }
+    }
+}
+
+/*********************************************************************************
+ * @brief   Take the keys pressed on the maintenance keypad
+ * @details The keys act on press, the releases are dropped:
+ *              * '1', '2', '3': force the peak, off-peak, night flash plan
+ *              * '0': follow the schedule again
+ *              * '*': place a pedestrian call, like the button
+ *              * '#': place a cars' call, like the detector
+ *              * 'A': place a transit priority call, the contact of the 
+ *                  transit receiver is wired across this key
+ *          A plan is taken at the next cycle boundary, like the scheduled ones
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_ReadKeypad(void) {
+    KEYPAD_EVENT_t event;
+
+    while(ERROR_OK == KEYPAD_GetEvent(&event)) {
+        if(FALSE == event.isPressed) {
+            continue;
+        }
+
+        switch(event.key) {
+            case '1':
+                appManualPlan = RTC_PLAN_PEAK;
+                break;
+            case '2':
+                appManualPlan = RTC_PLAN_OFF_PEAK;
+                break;
+            case '3':
+                appManualPlan = RTC_PLAN_NIGHT_FLASH;
+                break;
+            case '0':
+                appManualPlan = NUM_OF_RTC_PLANS;
+                break;
+            case '*':
+                if(!isPedCalled) {
+                    isPedCalled = TRUE;
+                    appPedCallMs = appNowMs;
+                }
+                break;
+            case '#':
+                isCarsCalled = TRUE;
+                break;
+            case 'A':
+                APP_CallTransit();
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/*********************************************************************************
+ * @brief   Take the preemption calls
+ * @details An edge seen by the ISR, or the input found low without one, e.g. 
+ *          after a reset, places a call. Only the calls placed by an edge are
+ *          timed, see \ref APP_TimePreempt
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_ReadPreempt(void) {
+    STATE_t level = HIGH;
+    BOOL_t isEdge = FALSE;
+
+    if(!PREEMPT_ENABLE) {
+        return;
+    }
+
+    if(isPreemptPending) {
+        GIE_Disable();
+        appPreemptEdgeUs = appPreemptUs;
+        isPreemptPending = FALSE;
+        GIE_Enable();
+
+        isEdge = TRUE;
+    }
+
+    DIO_ReadPin(DIO_PINS_PREEMPT, &level);
+    isPreemptHeld = (LOW == level) ? TRUE : FALSE;
+
+    if( (isEdge || isPreemptHeld) && !isPreemptCalled ) {
+        isPreemptCalled = TRUE;
+        isPreemptTiming = isEdge;
+
+        /* The emergency vehicle comes first, the bus is not waited for */
+        isTransitCalled = FALSE;
+
+        if(appPreempts < 0xFFFFU) {
+            appPreempts++;
+        }
+    }
+}
+
+/*********************************************************************************
+ * @brief   Lead the state machine to the preempted green
+ * @details Called on every update while a preemption is called, before the 
+ *          state function, so no state can start a conflicting green:
+ *              * The cars' green is the preempted green, it is held
+ *              * The pedestrian's initial state has not given the walk yet, 
+ *                  its cars' yellow ends as a plain yellow, timed from its start
+ *              * The pedestrian's green goes to its clearance
+ *              * The cars' red is the all red, timed from its start
+ *              * The flash state goes to the all red
+ *          The yellow and the pedestrian's clearance are never shortened: 
+ *          they run to their end, then to the all red, see \ref APP_EndCycle
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_Preempt(void) {
+    switch(appState) {
+        case APP_STATE_CARS_GREEN:
+            APP_ChangeState(APP_STATE_PREEMPT_GREEN);
+            break;
+        case APP_STATE_PEDESTRIAN_INIT_STATE:
+            appState = APP_STATE_CARS_YELLOW;
+            isStateEntry = TRUE;
+            break;
+        case APP_STATE_PEDESTRIAN_GREEN_STATE:
+            APP_ChangeState(APP_STATE_PEDESTRIAN_FINAL_STATE);
+            break;
+        case APP_STATE_CARS_RED:
+            appState = APP_STATE_PREEMPT_CLEAR;
+            isStateEntry = TRUE;
+            break;
+        case APP_STATE_INIT:
+        case APP_STATE_FLASH:
+            APP_ChangeState(APP_STATE_PREEMPT_CLEAR);
+            break;
+        default:
+            /* On its way, or already in the preempted green */
+            break;
+    }
+}
+
+/*********************************************************************************
+ * @brief   Time the call taken by this update
+ * @details Called after the state function, that wrote the lamps of the first
+ *          state of the transition. Latency = time of the edge to now
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_TimePreempt(void) {
+    u32_t u32LatencyUs = 0;
+
+    if(!isPreemptTiming) {
+        return;
+    }
+
+    isPreemptTiming = FALSE;
+
+    GIE_Disable();
+    u32LatencyUs = TIMER_GetTimeUs() - appPreemptEdgeUs;
+    GIE_Enable();
+
+    if( !isPreemptTimed || (u32LatencyUs > appPreemptMaxLatencyUs) ) {
+        appPreemptMaxLatencyUs = u32LatencyUs;
+    }
+
+    if( (u32LatencyUs > PREEMPT_MAX_LATENCY_US) && (appPreemptOverruns < 0xFFFFU) ) {
+        appPreemptOverruns++;
+    }
+
+    isPreemptTimed = TRUE;
+}
+
+/*********************************************************************************
+ * @brief   Time the period of the control loop
+ * @details Called at the start of each update. A call of the preemption is 
+ *          taken by the update that follows its edge, so the longest period
+ *          bounds its latency: the periods over PREEMPT_MAX_LATENCY_US are 
+ *          counted. The first update after the init is not timed
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_TimeLoop(void) {
+    u32_t u32NowUs = 0;
+
+    GIE_Disable();
+    u32NowUs = TIMER_GetTimeUs();
+    GIE_Enable();
+
+    if(isLoopTimed) {
+        if((u32NowUs - appLoopUs) > appLoopMaxUs) {
+            appLoopMaxUs = u32NowUs - appLoopUs;
+        }
+
+        if( ((u32NowUs - appLoopUs) > PREEMPT_MAX_LATENCY_US) && (appLoopOverruns < 0xFFFFU) ) {
+            appLoopOverruns++;
+        }
+    }
+
+    appLoopUs = u32NowUs;
+    isLoopTimed = TRUE;
+}
+
+/*********************************************************************************
+ * @brief   Place a transit priority call
+ * @details Dropped while a call is pending, in the cycles of the lockout, in 
+ *          the night flash plan and during a preemption
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_CallTransit(void) {
+    if( !TSP_ENABLE || isTransitCalled || (0U != appTransitLockout) || 
+        appPlan->isFlash || isPreemptCalled ) {
+        return;
+    }
+
+    isTransitCalled = TRUE;
+    appTransitCallMs = appNowMs;
+    isTransitExtending = FALSE;
+    appTransitSavedMs = 0;
+}
+
+/*********************************************************************************
+ * @brief   Hold the cars' green for a bus
+ * @details Called when the green would end. The first call is the end the 
+ *          green would have had. The green is held until the bus is through, 
+ *          TSP_TRAVEL_MS after its call, for at most TSP_MAX_EXTEND_MS. 
+ *          The delay saved is the wait of the bus for the next green without 
+ *          the extension: the yellow and the red, and the pedestrian's states
+ *          if one waits, less the extension. A bus through before the end of
+ *          the green is not served: nothing is counted, and no lockout
+ * @param   void
+ * @return  BOOL_t: TRUE to hold the green
+ ********************************************************************************/
+static BOOL_t APP_ExtendGreen(void) {
+    u32_t u32ExtendMs = 0;
+    u32_t u32ClearMs = 0;
+
+    if(!isTransitCalled) {
+        return FALSE;
+    }
+
+    if(!isTransitExtending) {
+        isTransitExtending = TRUE;
+        appTransitEndMs = appNowMs;
+    }
+
+    u32ExtendMs = appNowMs - appTransitEndMs;
+
+    if((appNowMs - appTransitCallMs) >= TSP_TRAVEL_MS) {
+        /* Through before the end of the green: no priority was given */
+        if(0UL == u32ExtendMs) {
+            isTransitCalled = FALSE;
+            return FALSE;
+        }
+
+        u32ClearMs = (isPedCalled ? 3UL : 2UL) * STATE_TIME_MS;
+
+        if(u32ClearMs > u32ExtendMs) {
+            appTransitSavedMs += u32ClearMs - u32ExtendMs;
+        }
+
+        APP_ServeTransit();
+        return FALSE;
+    }
+
+    /* Out of limits: the call is kept for an early green */
+    if( (u32ExtendMs >= TSP_MAX_EXTEND_MS) || 
+        (isPedCalled && ((appNowMs - appPedCallMs) >= PED_SERVE_DEADLINE_MS)) ) {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*********************************************************************************
+ * @brief   Cut the pedestrian's walk or the cars' red for a bus
+ * @details The state ends TSP_MIN_WALK_MS or TSP_MIN_RED_MS after its start 
+ *          instead of STATE_TIME_MS, the time cut is added to the delay saved
+ * @param   stateMs: time in the state, less than STATE_TIME_MS
+ * @return  BOOL_t: TRUE to end the state now
+ ********************************************************************************/
+static BOOL_t APP_IsEarlyGreen(const u32_t stateMs) {
+    u32_t u32MinMs = (APP_STATE_CARS_RED == appState) ? TSP_MIN_RED_MS : TSP_MIN_WALK_MS;
+
+    if( !isTransitCalled || (stateMs < u32MinMs) ) {
+        return FALSE;
+    }
+
+    appTransitSavedMs += STATE_TIME_MS - stateMs;
+
+    return TRUE;
+}
+
+/*********************************************************************************
+ * @brief   Serve the transit call, and count it in the EEPROM
+ * @details The delay saved is rounded to the second. The next calls are 
+ *          dropped until TSP_LOCKOUT_CYCLES more greens have started, so 
+ *          the cycle recovers: the pedestrians get their full walk, and the 
+ *          coordination corrects the phase
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_ServeTransit(void) {
+    isTransitCalled = FALSE;
+    appTransitLockout = TSP_LOCKOUT_CYCLES + 1U;
+
+    EEPROM_CounterAdd(EEPROM_COUNTER_TRANSIT_CALLS, 1);
+    EEPROM_CounterAdd(EEPROM_COUNTER_TRANSIT_SAVED_S, (appTransitSavedMs + 500UL) / 1000UL);
+}
+
+/*********************************************************************************
+ * @brief   Serve the pending pedestrian call, if any
+ * @details Called during the pedestrian's green, the wait of the call is added 
+ *          to the statistics
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_ServePedestrianCall(void) {
+    u32_t u32WaitMs = 0;
+    u32_t u32Bin = 0;
+
+    if(!isPedCalled) {
+        return;
+    }
+
+    isPedCalled = FALSE;
+    isCyclePedServed = TRUE;
+    u32WaitMs = appNowMs - appPedCallMs;
+
+    EEPROM_CounterAdd(EEPROM_COUNTER_PED_CALLS, 1);
+
+    u32Bin = u32WaitMs / PED_WAIT_BIN_MS;
+    if(u32Bin > (PED_WAIT_BINS - 1UL)) {
+        u32Bin = PED_WAIT_BINS - 1UL;
+    }
+
+    /* Saturate, the percentiles stay right until one bin is full */
+    if( (appPedWaitHistogram[u32Bin] < 0xFFFFU) && (appPedServed < 0xFFFFU) ) {
+        appPedWaitHistogram[u32Bin]++;
+        appPedServed++;
+    }
+
+    if(u32WaitMs > appPedMaxWaitMs) {
+        appPedMaxWaitMs = u32WaitMs;
+    }
+}
+
+/*********************************************************************************
+ * @brief   Take the plan of the schedule, or the one forced from the keypad
+ * @details Called at the cycle boundary only, so a cycle never mixes the times 
+ *          of two plans. The RTC updates the plan on schedule, this is not a 
+ *          read of the clock.
+ *          A staged set of plans becomes the active one by swapping the two 
+ *          pointers. The plans are only read by the loop, the command link 
+ *          included, so the swap needs no critical section. The old set
+ *          is left as it is: the next edit copies the active set over it,
+ *          see \ref APP_StagePlans
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_ApplyPlan(void) {
+    RTC_PLAN_t plan = RTC_GetPlan();
+    APP_PLAN_t * pPlans = NULL;
+
+    if(appManualPlan < NUM_OF_RTC_PLANS) {
+        plan = appManualPlan;
+    } else if(plan >= NUM_OF_RTC_PLANS) {
+        /* Keep the plan of the last cycle */
+        plan = (RTC_PLAN_t)(appPlan - appPlans);
+    }
+
+    if(isPlanStaged) {
+        isPlanStaged = FALSE;
+
+        pPlans = appPlans;
+        appPlans = appStagedPlans;
+        appStagedPlans = pPlans;
+    }
+
+    appPlan = &appPlans[plan];
+}
+
+/*********************************************************************************
+ * @brief   Start the next cycle
+ * @details Called at the end of the cars' red and of the pedestrian's final 
+ *          state, the cars' red is shown in both. The scheduled plan is taken,
+ *          then the next state is the all red of a pending preemption, the 
+ *          flash state for the night flash plan, 
+ *          the cars' green if a vehicle is waiting, otherwise the cars' red
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_EndCycle(void) {
+    APP_ApplyPlan();
+
+    /* The resumed state ran to its end */
+    appRestarts = 0;
+
+    if(isPreemptCalled) {
+        APP_ChangeState(APP_STATE_PREEMPT_CLEAR);
+    } else if(appPlan->isFlash) {
+        APP_ChangeState(APP_STATE_FLASH);
+    } else if(isCarsCalled || isSyncReceived || isTransitCalled) {
+        /* In coordination, the green is never skipped */
+        APP_ChangeState(APP_STATE_CARS_GREEN);
+    } else if(APP_STATE_CARS_RED != appState) {
+        APP_ChangeState(APP_STATE_CARS_RED);
+    } else {
+        /* No demand: skip the green, rest in red */
+    }
+}
+
+/*********************************************************************************
+ * @brief   Track the corridor sync pulses
+ * @details A new pulse is timed by the tick, coordination stops when no pulse 
+ *          came for COORD_SYNC_TIMEOUT_MS
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_ReadSync(void) {
+    if(isSyncPending) {
+        isSyncPending = FALSE;
+        isSyncReceived = TRUE;
+        appSyncMs = appNowMs;
+    }
+
+    if( isSyncReceived && ((appNowMs - appSyncMs) >= COORD_SYNC_TIMEOUT_MS) ) {
+        isSyncReceived = FALSE;
+    }
+}
+
+/*********************************************************************************
+ * @brief   Measure the phase error at the start of the cars' green
+ * @details The green should start COORD_OFFSET_MS after a sync pulse, modulo 
+ *          the cycle. The error is in ]-COORD_CYCLE_MS/2, COORD_CYCLE_MS/2], 
+ *          positive when the green is late. It is corrected by shrinking this
+ *          green by up to COORD_MAX_ADJUST_MS, or stretching it when negative.
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_MeasurePhase(void) {
+    u32_t u32NowUs = 0;
+    u32_t u32SyncUs = 0;
+    u32_t u32PhaseUs = 0;
+    s32_t s32AdjustMs = 0;
+
+    isCoordinated = isSyncReceived;
+
+    if(!isCoordinated) {
+        appGreenAdjustMs = 0;
+        return;
+    }
+
+    GIE_Disable();
+    u32NowUs = TIMER_GetTimeUs();
+    u32SyncUs = appSyncUs;
+    GIE_Enable();
+
+    /* A cycle is added before the offset is taken, the difference never wraps */
+    u32PhaseUs = (u32NowUs - u32SyncUs) % (COORD_CYCLE_MS * 1000UL);
+    u32PhaseUs = (u32PhaseUs + ((COORD_CYCLE_MS - COORD_OFFSET_MS) * 1000UL)) % (COORD_CYCLE_MS * 1000UL);
+
+    if(u32PhaseUs > (COORD_CYCLE_MS * 500UL)) {
+        appPhaseErrorUs = (s32_t)u32PhaseUs - (s32_t)(COORD_CYCLE_MS * 1000UL);
+    } else {
+        appPhaseErrorUs = (s32_t)u32PhaseUs;
+    }
+
+    /* A part of the error is corrected in each cycle, the platoons see a smooth change */
+    s32AdjustMs = appPhaseErrorUs / 1000L;
+
+    if(s32AdjustMs > (s32_t)COORD_MAX_ADJUST_MS) {
+        s32AdjustMs = (s32_t)COORD_MAX_ADJUST_MS;
+    } else if(s32AdjustMs < -(s32_t)COORD_MAX_ADJUST_MS) {
+        s32AdjustMs = -(s32_t)COORD_MAX_ADJUST_MS;
+    } else {
+        /* Corrected in this cycle */
+    }
+
+    appGreenAdjustMs = s32AdjustMs;
+}
+
+/*********************************************************************************
+ * @brief   Keep the demand of the cycle that ends, and update the adaptive 
+ *          cycle every ADAPT_UPDATE_CYCLES cycles
+ * @details Called at the start of each cars' green, the cycle boundary of the
+ *          adaptive cycle. The window is a ring of the last cycles, with the
+ *          sums of their times and counts: the oldest cycle is taken out of 
+ *          the sums as the new one is put in. The work is done in the loop, 
+ *          once per cycle: the ISRs only time the loop edges
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_Adapt(void) {
+    APP_CYCLE_SAMPLE_t * const pSample = &appCycles[appCycleIndex];
+    u32_t u32OccupiedMs = 0;
+    u32_t u32Vehicles = 0;
+
+    if(!ADAPT_ENABLE) {
+        return;
+    }
+
+    u32OccupiedMs = SPEED_GetOccupancyMs();
+    u32Vehicles = appCarsCount - appCycleCarsCount;
+
+    if(isCycleStarted) {
+        if(appCyclesKept < ADAPT_WINDOW_CYCLES) {
+            appCyclesKept++;
+        } else {
+            appWindowMs -= pSample->cycleMs;
+            appWindowOccupiedMs -= pSample->occupiedMs;
+            appWindowVehicles -= pSample->vehicles;
+            appWindowPedCycles -= pSample->isPedServed ? 1U : 0U;
+        }
+
+        pSample->cycleMs = appNowMs - appCycleStartMs;
+        pSample->occupiedMs = u32OccupiedMs - appCycleOccupiedMs;
+        if(pSample->occupiedMs > pSample->cycleMs) {
+            pSample->occupiedMs = pSample->cycleMs;
+        }
+        pSample->vehicles = (u32Vehicles > 0xFFFFUL) ? 0xFFFFU : (u16_t)u32Vehicles;
+        pSample->isPedServed = isCyclePedServed;
+
+        appWindowMs += pSample->cycleMs;
+        appWindowOccupiedMs += pSample->occupiedMs;
+        appWindowVehicles += pSample->vehicles;
+        appWindowPedCycles += pSample->isPedServed ? 1U : 0U;
+
+        appCycleIndex = (u8_t)((appCycleIndex + 1U) % ADAPT_WINDOW_CYCLES);
+
+        if(appCyclesToUpdate > 1U) {
+            appCyclesToUpdate--;
+        } else if( (appCyclesKept == ADAPT_WINDOW_CYCLES) && (0UL != appWindowMs) ) {
+            appCyclesToUpdate = ADAPT_UPDATE_CYCLES;
+            APP_UpdateCycle();
+        } else {
+            /* The window is not full yet */
+        }
+    }
+
+    isCycleStarted = TRUE;
+    appCycleStartMs = appNowMs;
+    appCycleCarsCount = appCarsCount;
+    appCycleOccupiedMs = u32OccupiedMs;
+    isCyclePedServed = FALSE;
+}
+
+/*********************************************************************************
+ * @brief   Compute the adaptive cycle and the cars' green from the window
+ * @details In fixed point, the ratios in 1/4096:
+ *              * Y: the larger of the share of the window the vehicles need at 
+ *                  the saturation headway, and the occupancy of the loop. A 
+ *                  queue standing over the loop is counted once but keeps it
+ *                  occupied. Kept below ADAPT_MAX_FLOW_RATIO
+ *              * L: the lost time of a cycle, the yellow and the red, or the 3
+ *                  pedestrian's states, weighted by the cycles that served one
+ *              * C = (1.5 L + 5 s) / (1 - Y), in ADAPT_MIN_CYCLE_MS to 
+ *                  ADAPT_MAX_CYCLE_MS
+ *          The cars' green is C - L, changed by at most ADAPT_MAX_STEP_MS
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_UpdateCycle(void) {
+    u32_t u32WindowMs = appWindowMs;
+    u32_t u32DemandMs = appWindowVehicles * ADAPT_SAT_HEADWAY_MS;
+    u32_t u32OccupiedMs = appWindowOccupiedMs;
+    u32_t u32FlowRatio = 0;
+    u32_t u32OccupancyRatio = 0;
+    u32_t u32LostMs = 0;
+    u32_t u32CycleMs = 0;
+    u32_t u32GreenMs = 0;
+    u32_t u32PreviousMs = isAdaptive ? appAdaptGreenMs : appPlan->maxGreenMs;
+
+    if(u32DemandMs > u32WindowMs) {
+        u32DemandMs = u32WindowMs;
+    }
+
+    /* The times are shifted by ADAPT_Q bits: scale the window below 2^20 ms */
+    while(u32WindowMs >= (1UL << (32U - ADAPT_Q))) {
+        u32WindowMs >>= 1;
+        u32DemandMs >>= 1;
+        u32OccupiedMs >>= 1;
+    }
+
+    u32FlowRatio = (u32DemandMs << ADAPT_Q) / u32WindowMs;
+    u32OccupancyRatio = (u32OccupiedMs << ADAPT_Q) / u32WindowMs;
+
+    if(u32OccupancyRatio > u32FlowRatio) {
+        u32FlowRatio = u32OccupancyRatio;
+    }
+
+    if(u32FlowRatio > ADAPT_MAX_FLOW_RATIO) {
+        u32FlowRatio = ADAPT_MAX_FLOW_RATIO;
+    }
+
+    u32LostMs = (2UL * STATE_TIME_MS) + ((STATE_TIME_MS * appWindowPedCycles) / ADAPT_WINDOW_CYCLES);
+
+    u32CycleMs = ((((3UL * u32LostMs) / 2UL) + 5000UL) << ADAPT_Q) / (ADAPT_ONE - u32FlowRatio);
+
+    if(u32CycleMs < ADAPT_MIN_CYCLE_MS) {
+        u32CycleMs = ADAPT_MIN_CYCLE_MS;
+    } else if(u32CycleMs > ADAPT_MAX_CYCLE_MS) {
+        u32CycleMs = ADAPT_MAX_CYCLE_MS;
+    } else {
+        /* Within limits */
+    }
+
+    u32GreenMs = u32CycleMs - u32LostMs;
+
+    if(u32GreenMs > (u32PreviousMs + ADAPT_MAX_STEP_MS)) {
+        u32GreenMs = u32PreviousMs + ADAPT_MAX_STEP_MS;
+    } else if((u32GreenMs + ADAPT_MAX_STEP_MS) < u32PreviousMs) {
+        u32GreenMs = u32PreviousMs - ADAPT_MAX_STEP_MS;
+    } else {
+        /* A smooth change */
+    }
+
+    appAdaptCycleMs = u32CycleMs;
+    appAdaptGreenMs = u32GreenMs;
+    isAdaptive = TRUE;
+}
+
+/*********************************************************************************
+ * @brief   Max green of the cars in this cycle
+ * @details The adaptive green once computed, never less than the plan's min 
+ *          green, the plan's max green otherwise
+ * @param   void
+ * @return  u32_t: the max green in milliseconds
+ ********************************************************************************/
+static u32_t APP_GetMaxGreenMs(void) {
+    if(!isAdaptive) {
+        return appPlan->maxGreenMs;
+    }
+
+    return (appAdaptGreenMs < appPlan->minGreenMs) ? appPlan->minGreenMs : appAdaptGreenMs;
+}
+
+/*********************************************************************************
+ * @brief   Handle a frame of the command link, see \ref APP_COMMAND_t
+ * @details Called by \ref PROTOCOL_Update, in the loop of the state machine: 
+ *          the live variables are stable and are sent from where they live,
+ *          with no snapshot copy. The room for the reply is reserved by the 
+ *          protocol
+ * @param   type: the command
+ * @param   pPayload: its parameters
+ * @param   length: the length of the parameters
+ * @return  void
+ ********************************************************************************/
+static void APP_HandleCommand(const u8_t type, const u8_t * const pPayload, const u8_t length) {
+    ERROR_t error = ERROR_OK;
+    u8_t u8Reply = type | APP_REPLY_FLAG;
+    u8_t u8Status = 0;
+    u8_t u8Plan = 0;
+    u8_t u8Count = 0;
+    u8_t u8Source = 0;
+    const APP_PLAN_t * pPlan = NULL;
+    u32_t au32Counters[NUM_OF_EEPROM_COUNTERS];
+    SPEED_RECORD_t aRecords[APP_TRACE_RECORDS];
+    RTC_TIME_t time;
+
+    switch(type) {
+        case APP_COMMAND_GET_STATE:
+            u8Plan = (u8_t)(appPlan - appPlans);
+
+            error = PROTOCOL_BeginFrame(u8Reply, 
+                        sizeof(u8Status) + sizeof(appState) + sizeof(appNowMs) + 
+                        sizeof(appStateStartMs) + sizeof(isPedCalled) + sizeof(appPedCallMs) + 
+                        sizeof(isCarsCalled) + sizeof(isCoordinated) + sizeof(appPhaseErrorUs) + 
+                        sizeof(appGreenAdjustMs) + sizeof(u8Plan) + sizeof(*appPlan) + 
+                        sizeof(appAdaptCycleMs) + sizeof(appAdaptGreenMs));
+            if(ERROR_OK != error) {
+                break;
+            }
+
+            PROTOCOL_AddPayload(&u8Status, sizeof(u8Status));
+            PROTOCOL_AddPayload(&appState, sizeof(appState));
+            PROTOCOL_AddPayload(&appNowMs, sizeof(appNowMs));
+            PROTOCOL_AddPayload(&appStateStartMs, sizeof(appStateStartMs));
+            PROTOCOL_AddPayload(&isPedCalled, sizeof(isPedCalled));
+            PROTOCOL_AddPayload(&appPedCallMs, sizeof(appPedCallMs));
+            PROTOCOL_AddPayload(&isCarsCalled, sizeof(isCarsCalled));
+            PROTOCOL_AddPayload(&isCoordinated, sizeof(isCoordinated));
+            PROTOCOL_AddPayload(&appPhaseErrorUs, sizeof(appPhaseErrorUs));
+            PROTOCOL_AddPayload(&appGreenAdjustMs, sizeof(appGreenAdjustMs));
+            PROTOCOL_AddPayload(&u8Plan, sizeof(u8Plan));
+            PROTOCOL_AddPayload(appPlan, sizeof(*appPlan));
+            PROTOCOL_AddPayload(&appAdaptCycleMs, sizeof(appAdaptCycleMs));
+            PROTOCOL_AddPayload(&appAdaptGreenMs, sizeof(appAdaptGreenMs));
+            PROTOCOL_EndFrame();
+            return;
+
+        case APP_COMMAND_GET_COUNTERS:
+            /* The EEPROM counters are cached in RAM, the reads never wait */
+            for(u8Count = 0; u8Count < NUM_OF_EEPROM_COUNTERS; u8Count++) {
+                error |= EEPROM_CounterRead((EEPROM_COUNTER_t)u8Count, &au32Counters[u8Count]);
+            }
+            if(ERROR_OK != error) {
+                break;
+            }
+
+            u8Source = (u8_t)WDT_GetResetSource();
+
+            error = PROTOCOL_BeginFrame(u8Reply, 
+                        sizeof(u8Status) + sizeof(au32Counters) + sizeof(appCarsCount) + 
+                        sizeof(appPedServed) + sizeof(appPedMaxWaitMs) + 
+                        sizeof(u8Source) + sizeof(isResumed) + 
+                        sizeof(appPreempts) + sizeof(appPreemptMaxLatencyUs) + 
+                        sizeof(appLoopMaxUs) + sizeof(appPreemptOverruns) + 
+                        sizeof(appLoopOverruns));
+            if(ERROR_OK != error) {
+                break;
+            }
+
+            PROTOCOL_AddPayload(&u8Status, sizeof(u8Status));
+            PROTOCOL_AddPayload(au32Counters, sizeof(au32Counters));
+            PROTOCOL_AddPayload(&appCarsCount, sizeof(appCarsCount));
+            PROTOCOL_AddPayload(&appPedServed, sizeof(appPedServed));
+            PROTOCOL_AddPayload(&appPedMaxWaitMs, sizeof(appPedMaxWaitMs));
+            PROTOCOL_AddPayload(&u8Source, sizeof(u8Source));
+            PROTOCOL_AddPayload(&isResumed, sizeof(isResumed));
+            PROTOCOL_AddPayload(&appPreempts, sizeof(appPreempts));
+            PROTOCOL_AddPayload(&appPreemptMaxLatencyUs, sizeof(appPreemptMaxLatencyUs));
+            PROTOCOL_AddPayload(&appLoopMaxUs, sizeof(appLoopMaxUs));
+            PROTOCOL_AddPayload(&appPreemptOverruns, sizeof(appPreemptOverruns));
+            PROTOCOL_AddPayload(&appLoopOverruns, sizeof(appLoopOverruns));
+            PROTOCOL_EndFrame();
+            return;
+
+        case APP_COMMAND_GET_TRACE:
+            /* The speed trap has its own ring, the records are taken out of it */
+            while( (u8Count < APP_TRACE_RECORDS) && (ERROR_OK == SPEED_Read(&aRecords[u8Count])) ) {
+                u8Count++;
+            }
+
+            error = PROTOCOL_BeginFrame(u8Reply, sizeof(u8Status) + (u8Count * sizeof(SPEED_RECORD_t)));
+            if(ERROR_OK != error) {
+                break;
+            }
+
+            PROTOCOL_AddPayload(&u8Status, sizeof(u8Status));
+            if(0 != u8Count) {
+                PROTOCOL_AddPayload(aRecords, u8Count * sizeof(SPEED_RECORD_t));
+            }
+            PROTOCOL_EndFrame();
+            return;
+
+        case APP_COMMAND_GET_PLAN:
+        case APP_COMMAND_SET_PLAN:
+            if( (0 == length) || (pPayload[0] >= NUM_OF_RTC_PLANS) ) {
+                error = ERROR_INVALID_PARAMETER;
+                break;
+            }
+
+            u8Plan = pPayload[0];
+
+            if(APP_COMMAND_SET_PLAN == type) {
+                error = APP_SetPlan(pPayload, length);
+                if(ERROR_OK != error) {
+                    break;
+                }
+            }
+
+            /* GET_PLAN reads the active times, SET_PLAN replies with the staged ones */
+            pPlan = (APP_COMMAND_SET_PLAN == type) ? &appStagedPlans[u8Plan] : &appPlans[u8Plan];
+
+            error = PROTOCOL_BeginFrame(u8Reply, sizeof(u8Status) + sizeof(u8Plan) + sizeof(*pPlan));
+            if(ERROR_OK != error) {
+                break;
+            }
+
+            PROTOCOL_AddPayload(&u8Status, sizeof(u8Status));
+            PROTOCOL_AddPayload(&u8Plan, sizeof(u8Plan));
+            PROTOCOL_AddPayload(pPlan, sizeof(*pPlan));
+            PROTOCOL_EndFrame();
+            return;
+
+        case APP_COMMAND_SAVE_PLANS:
+            error = APP_SavePlans();
+            break;
+
+        case APP_COMMAND_SET_TIME:
+            if(3U != length) {
+                error = ERROR_INVALID_PARAMETER;
+                break;
+            }
+
+            time.hours = pPayload[0];
+            time.minutes = pPayload[1];
+            time.seconds = pPayload[2];
+            error = RTC_SetTime(&time);
+            break;
+
+        default:
+            error = ERROR_ILLEGAL_PARAM;
+            break;
+    }
+
+    /* Status only: an error, or a command with no data to return */
+    u8Status = (u8_t)error;
+    PROTOCOL_SendFrame(u8Reply, &u8Status, sizeof(u8Status));
+}
+
+/*********************************************************************************
+ * @brief   Stage the times of a plan, from a SET_PLAN command
+ * @details The times are written in the staged set, and taken at the next 
+ *          cycle boundary: a cycle never runs with half written times. The 
+ *          night flash plan has no times
+ * @param   pPayload: plan index, min green, passage and max green
+ * @param   length: the length of the payload
+ * @return  ERROR_t: ERROR_OUT_OF_RANGE if the times are refused. See \ref ERROR_t
+ ********************************************************************************/
+static ERROR_t APP_SetPlan(const u8_t * const pPayload, const u8_t length) {
+    APP_PLAN_t * pPlan = NULL;
+    u32_t u32MinGreenMs = 0;
+    u32_t u32PassageMs = 0;
+    u32_t u32MaxGreenMs = 0;
+    ERROR_t error = ERROR_OK;
+
+    if(13U != length) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    /* The staged set is not valid before the first edit */
+    if(appPlans[pPayload[0]].isFlash) {
+        return ERROR_ILLEGAL_PARAM;
+    }
+
+    u32MinGreenMs = APP_GetU32(&pPayload[1]);
+    u32PassageMs = APP_GetU32(&pPayload[5]);
+    u32MaxGreenMs = APP_GetU32(&pPayload[9]);
+
+    error = APP_CheckPlan(u32MinGreenMs, u32PassageMs, u32MaxGreenMs);
+    if(ERROR_OK != error) {
+        return error;
+    }
+
+    APP_StagePlans();
+
+    pPlan = &appStagedPlans[pPayload[0]];
+    pPlan->minGreenMs = u32MinGreenMs;
+    pPlan->passageMs = u32PassageMs;
+    pPlan->maxGreenMs = u32MaxGreenMs;
+    isPlanStaged = TRUE;
+
+    return ERROR_OK;
+}
+
+/*********************************************************************************
+ * @brief   Check the times of a plan
+ * @details Against the same guarantees as the plans of app_cfg.h, the floor
+ *          of the min green and a passage time that is not 0 included
+ * @param   minGreenMs: the min green
+ * @param   passageMs: the passage time
+ * @param   maxGreenMs: the max green
+ * @return  ERROR_t: ERROR_OUT_OF_RANGE if the times are refused. See \ref ERROR_t
+ ********************************************************************************/
+static ERROR_t APP_CheckPlan(const u32_t minGreenMs, const u32_t passageMs, const u32_t maxGreenMs) {
+    if( (minGreenMs < PLAN_MIN_GREEN_FLOOR_MS) || (0UL == passageMs) ||
+        (minGreenMs > maxGreenMs) || (passageMs > maxGreenMs) ||
+        (PED_MAX_WAIT_MS < ((2UL * STATE_TIME_MS) + minGreenMs)) ||
+        (COORD_CYCLE_MS < ((3UL * STATE_TIME_MS) + COORD_MAX_ADJUST_MS + minGreenMs)) ) {
+        return ERROR_OUT_OF_RANGE;
+    }
+
+    return ERROR_OK;
+}
+
+/*********************************************************************************
+ * @brief   Start the staged set from the active one, before the first edit
+ * @details An edit writes one plan, the others of the staged set must be the
+ *          active ones. The copy is made here, when a plan is staged, so the
+ *          cycle boundary only swaps the two pointers
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_StagePlans(void) {
+    u8_t i = 0;
+
+    if(isPlanStaged) {
+        return;
+    }
+
+    for(i = 0; i < NUM_OF_RTC_PLANS; i++) {
+        appStagedPlans[i] = appPlans[i];
+    }
+}
+
+/*********************************************************************************
+ * @brief   Stage the plans saved in the EEPROM
+ * @details Called from APP_Init, before any EEPROM write is queued: the reads
+ *          of the EEPROM return ERROR_BUSY while a byte is written. The staged
+ *          set starts from the active one, then each plan with a right CRC and
+ *          valid times takes the times of its record. They are swapped in at the 
+ *          first cycle boundary. A blank EEPROM keeps the plans of app_cfg.h
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_LoadPlans(void) {
+    APP_PLAN_RECORD_t record;
+    u8_t i = 0;
+
+    APP_StagePlans();
+
+    for(i = 0; i < NUM_OF_RTC_PLANS; i++) {
+        if(appPlans[i].isFlash) {
+            continue;
+        }
+
+        if( (ERROR_OK != EEPROM_ReadBlock(APP_PLANS_EEPROM_ADDRESS + ((u16_t)i * sizeof(record)), 
+                                          (u8_t *)&record, sizeof(record))) ||
+            (APP_RECORD_CRC(record) != record.crc) ||
+            (ERROR_OK != APP_CheckPlan(record.minGreenMs, record.passageMs, record.maxGreenMs)) ) {
+            continue;
+        }
+
+        appStagedPlans[i].minGreenMs = record.minGreenMs;
+        appStagedPlans[i].passageMs = record.passageMs;
+        appStagedPlans[i].maxGreenMs = record.maxGreenMs;
+        isPlanStaged = TRUE;
+    }
+}
+
+/*********************************************************************************
+ * @brief   Save the staged plans in the EEPROM, from a SAVE_PLANS command
+ * @details The active set is saved when no plan is staged. The records are
+ *          written in the background by the EEPROM driver
+ * @param   void
+ * @return  ERROR_t: ERROR_BUSY if the EEPROM is writing. See \ref ERROR_t
+ ********************************************************************************/
+static ERROR_t APP_SavePlans(void) {
+    const APP_PLAN_t * const pPlans = isPlanStaged ? appStagedPlans : appPlans;
+    ERROR_t error = ERROR_OK;
+    APP_PLAN_RECORD_t record;
+    u8_t i = 0;
+
+    /* All the records are queued at once */
+    if(!EEPROM_IsIdle()) {
+        return ERROR_BUSY;
+    }
+
+    for(i = 0; i < NUM_OF_RTC_PLANS; i++) {
+        if(pPlans[i].isFlash) {
+            continue;
+        }
+
+        record.minGreenMs = pPlans[i].minGreenMs;
+        record.passageMs = pPlans[i].passageMs;
+        record.maxGreenMs = pPlans[i].maxGreenMs;
+        record.crc = APP_RECORD_CRC(record);
+
+        error |= EEPROM_WriteBlock(APP_PLANS_EEPROM_ADDRESS + ((u16_t)i * sizeof(record)), 
+                                   (const u8_t *)&record, sizeof(record));
+    }
+
+    return error;
+}
+
+/*********************************************************************************
+ * @brief   Read a little endian u32_t from a payload, at any alignment
+ * @param   pBytes: the first byte
+ * @return  u32_t: the value
+ ********************************************************************************/
+static u32_t APP_GetU32(const u8_t * const pBytes) {
+    return  (u32_t)pBytes[0]         | ((u32_t)pBytes[1] << 8) |
+           ((u32_t)pBytes[2] << 16)  | ((u32_t)pBytes[3] << 24);
+}
+
+/*********************************************************************************
+ * @brief   Notify the application of a corridor sync pulse
+ * @details Callback of the EXTI_1 ISR: the pulse is timed here, to the us. A 
+ *          pulse less than half a cycle after the previous one is a glitch
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_SyncNotify(void) {
+    u32_t u32NowUs = TIMER_GetTimeUs();
+
+    if( isSyncReceived && ((u32NowUs - appSyncUs) < (COORD_CYCLE_MS * 500UL)) ) {
+        return;
+    }
+
+    appSyncUs = u32NowUs;
+    isSyncPending = TRUE;
+}
+
+/*********************************************************************************
+ * @brief   Notify the application of a preemption call
+ * @details Callback of the EXTI_2 ISR: the edge is timed here, to the us
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_PreemptNotify(void) {
+    appPreemptUs = TIMER_GetTimeUs();
+    isPreemptPending = TRUE;
+}
+
+/*********************************************************************************
+ * @brief   Notify the application that the button is pressed
+ * @details This is a callback used by the EXTI deiver to notify the application 
+ *          that the button is pressed by setting the isButtonPressed flag to TRUE
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void EXTI_Notify(void) {
+    isButtonPressed = TRUE;
+}
+
+/*********************************************************************************
+ * @brief   Cars' green state
+ * @details This function is called when the system is in cars' green state, it
+ *          will turn on the cars' green light and pedestrian's red ligh, and 
+ *          turn off the other lights
+ *          The green lasts the plan's minimum green, then it is extended while 
+ *          vehicles come within its passage time of each other, up to its 
+ *          maximum green, or the adaptive one, see \ref APP_GetMaxGreenMs.
+ *          If a pedestrian waits for too long, it will change the state to 
+ *          pedestrian's init state.
+ *          The other ends of the green are held for a bus, see 
+ *          \ref APP_ExtendGreen
+ *          In coordination, the green is held until the cycle, less the states 
+ *          that follow, is over. It is then followed by pedestrian's init 
+ *          state if a pedestrian waits, by cars' yellow state otherwise
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_CarsGreenState(void) {
+    u32_t u32GreenMs = APP_GetStateTimeMs();
+    u32_t u32HoldMs = 0;
+
+    if(isStateEntry) {
+        isStateEntry = FALSE;
+
+        /* Configure the cars' and pedestrians' lights at once, the conflict
+           monitor never sees a mix of the old and new lights */
+        APP_SetLamps( LED_BIT(LED_CAR_G) |
+                      LED_BIT(LED_PEDESTRIAN_R) );
+
+        /* The gap is timed from the start of the green */
+        appLastActuationMs = appNowMs;
+
+        EEPROM_CounterAdd(EEPROM_COUNTER_CYCLES, 1);
+
+        APP_MeasurePhase();
+        APP_Adapt();
+
+        if(0U != appTransitLockout) {
+            appTransitLockout--;
+        }
+
+        /* An early green: the bus finds it. A call no state was cut for is 
+           kept for the extension of this green */
+        if(isTransitCalled && (0UL != appTransitSavedMs)) {
+            APP_ServeTransit();
+        } else {
+            isTransitExtending = FALSE;
+        }
+    }
+
+    if(u32GreenMs < appPlan->minGreenMs) {
+        return;
+    }
+
+    if(isCoordinated) {
+        /* The pedestrian's states are one state longer than yellow and red */
+        u32HoldMs = COORD_CYCLE_MS - ((isPedCalled ? 3UL : 2UL) * STATE_TIME_MS);
+        u32HoldMs = (u32_t)((s32_t)u32HoldMs - appGreenAdjustMs);
+
+        if( (u32GreenMs >= u32HoldMs) && !APP_ExtendGreen() ) {
+            APP_ChangeState(isPedCalled ? APP_STATE_PEDESTRIAN_INIT_STATE : APP_STATE_CARS_YELLOW);
+        }
+        return;
+    }
+
+    /* Gap-out: the vehicles are served, the next green needs a new call */
+    if( ((appNowMs - appLastActuationMs) >= appPlan->passageMs) && !APP_ExtendGreen() ) {
+        isCarsCalled = CARS_RECALL;
+        APP_ChangeState(APP_STATE_CARS_YELLOW);
+        return;
+    }
+
+    /* The green is cut while vehicles are still coming, their call is kept */
+    if( isPedCalled && ((appNowMs - appPedCallMs) >= PED_SERVE_DEADLINE_MS) ) {
+        APP_ChangeState(APP_STATE_PEDESTRIAN_INIT_STATE);
+    } else if( (u32GreenMs >= APP_GetMaxGreenMs()) && !APP_ExtendGreen() ) {
+        APP_ChangeState(APP_STATE_CARS_YELLOW);
+    } else {
+        /* Extend the green */
+    }
+}
+
+/*********************************************************************************
+ * @brief   Cars' yellow state
+ * @details This function is called when the system is in cars' yellow state, it
+ *          will blink the cars' yellow light and turn on the pedestrian's red ligh, 
+ *          and turn off the other lights
+ *          After 5 seconds it will change the state to cars' red state
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_CarsYellowState(void) {
+    if(isStateEntry) {
+        isStateEntry = FALSE;
+
+        /* Configure the cars' and pedestrians' lights */
+        APP_SetLamps( LED_BIT(LED_CAR_Y) |
+                      LED_BIT(LED_CAR_G) |
+                      LED_BIT(LED_PEDESTRIAN_R) );
+    }
+
+    if(APP_IsBlinkTime()) {
+        APP_ToggleLamp(LED_CAR_Y);
+    }
+
+    if(APP_GetStateTimeMs() >= STATE_TIME_MS) {
+        APP_ChangeState(APP_STATE_CARS_RED);
+    }
+}
+
+/*********************************************************************************
+ * @brief   Cars' red state
+ * @details This function is called when the system is in cars' red state, it
+ *          will turn on the cars' red light and pedestrian's red ligh, and 
+ *          turn off the other lights
+ *          After 5 seconds the cycle ends, see \ref APP_EndCycle: it rests in 
+ *          red until a vehicle comes. The red is cut for a bus, see 
+ *          \ref APP_IsEarlyGreen. If a pedestrian is waiting, it will 
+ *          change the state to pedestrian's green state
+ * 
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_CarsRedState(void) {
+    if(isStateEntry) {
+        isStateEntry = FALSE;
+
+        /* Configure the cars' and pedestrians' lights */
+        APP_SetLamps( LED_BIT(LED_CAR_R) |
+                      LED_BIT(LED_PEDESTRIAN_R) );
+    }
+
+    if(isPedCalled) {
+        APP_ChangeState(APP_STATE_PEDESTRIAN_GREEN_STATE);
+        return;
+    }
+
+    if( (APP_GetStateTimeMs() < STATE_TIME_MS) && !APP_IsEarlyGreen(APP_GetStateTimeMs()) ) {
+        return;
+    }
+
+    APP_EndCycle();
+}
+
+/*********************************************************************************
+ * @brief   Pedestrian's initial state
+ * @details This function is called when the system is in pedestrian's initial state, 
+ *          it will turn on the cars' green light and blink both car's yeallo and 
+ *          pedestrian's yellow lights, and turn off the other lights
+ *          After 5 seconds it will change the state to pedestrian's green state. 
+ *          A press is kept for the pedestrian's green
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_PedestrianInitState(void) {
+    if(isStateEntry) {
+        isStateEntry = FALSE;
+
+        /* Configure the cars' and pedestrians' lights */
+        APP_SetLamps( LED_BIT(LED_CAR_Y) |
+                      LED_BIT(LED_CAR_G) |
+                      LED_BIT(LED_PEDESTRIAN_Y) );
+    }
+
+    /* Blinking the yellow lights of both cars and pedestrians */
+    if(APP_IsBlinkTime()) {
+        APP_ToggleLamp(LED_PEDESTRIAN_Y);
+        APP_ToggleLamp(LED_CAR_Y);
+    }
+
+    if(APP_GetStateTimeMs() >= STATE_TIME_MS) {
+        APP_ChangeState(APP_STATE_PEDESTRIAN_GREEN_STATE);
+    }
+}
+
+/*********************************************************************************
+ * @brief   Pedestrian's green state
+ * @details This function is called when the system is in pedestrian's green state, 
+ *          it will turn on the cars' red light and pedestrian's green light, and 
+ *          turn off the other lights
+ *          After 5 seconds it will change the state to pedestrian's final state,
+ *          earlier for a bus, see \ref APP_IsEarlyGreen. 
+ *          The pending call, and any press during the green, are served
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_PedestrianGreenState(void) {
+    if(isStateEntry) {
+        isStateEntry = FALSE;
+
+        /* Configure the cars' and pedestrians' lights */
+        APP_SetLamps( LED_BIT(LED_CAR_R) |
+                      LED_BIT(LED_PEDESTRIAN_G) );
+    }
+
+    APP_ServePedestrianCall();
+
+    if( (APP_GetStateTimeMs() >= STATE_TIME_MS) || APP_IsEarlyGreen(APP_GetStateTimeMs()) ) {
+        APP_ChangeState(APP_STATE_PEDESTRIAN_FINAL_STATE);
+    }
+}
+
+/*********************************************************************************
+ * @brief   Pedestrian's final state
+ * @details This function is called when the system is in pedestrian's final state, 
+ *          it will turn on the cars' red light and blink both car's yeallo and 
+ *          pedestrian's yellow lights, and turn off the other lights
+ *          After 5 seconds the cycle ends, see \ref APP_EndCycle.
+ *          A press is kept for the next pedestrian's green
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_PedestrianFinalState(void) {
+    if(isStateEntry) {
+        isStateEntry = FALSE;
+
+        /* Configure the cars' and pedestrians' lights */
+        APP_SetLamps( LED_BIT(LED_CAR_Y) |
+                      LED_BIT(LED_PEDESTRIAN_Y) |
+                      LED_BIT(LED_PEDESTRIAN_G) );
+    }
+
+    /* Blinking the yellow lights of both cars and pedestrians */
+    if(APP_IsBlinkTime()) {
+        APP_ToggleLamp(LED_PEDESTRIAN_Y);
+        APP_ToggleLamp(LED_CAR_Y);
+    }
+
+    if(APP_GetStateTimeMs() >= STATE_TIME_MS) {
+        APP_EndCycle();
+    }
+}
+
+/*********************************************************************************
+ * @brief   Flash state
+ * @details This function is called when the system is in the flash state of the
+ *          night flash plan, it will blink the cars' yellow light and turn off 
+ *          the other lights. The crossing is unattended: the pedestrian calls 
+ *          are dropped.
+ *          When the schedule leaves the night flash plan, it will change the 
+ *          state to cars' red state, that starts the next cycle
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_FlashState(void) {
+    if(isStateEntry) {
+        isStateEntry = FALSE;
+
+        /* Configure the cars' and pedestrians' lights */
+        APP_SetLamps( LED_BIT(LED_CAR_Y) );
+    }
+
+    if(APP_IsBlinkTime()) {
+        APP_ToggleLamp(LED_CAR_Y);
+    }
+
+    isPedCalled = FALSE;
+    isTransitCalled = FALSE;
+
+    /* The time in flash is no cycle of the adaptive window */
+    isCycleStarted = FALSE;
+
+    APP_ApplyPlan();
+
+    if(!appPlan->isFlash) {
+        APP_ChangeState(APP_STATE_CARS_RED);
+    }
+}
+
+/*********************************************************************************
+ * @brief   All red before the preempted green
+ * @details This function is called when the system is in the all red of a 
+ *          preemption, it will turn on the cars' red light and pedestrian's 
+ *          red light, and turn off the other lights
+ *          After PREEMPT_ALL_RED_MS it will change the state to the preempted 
+ *          green state
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_PreemptClearState(void) {
+    if(isStateEntry) {
+        isStateEntry = FALSE;
+
+        /* Configure the cars' and pedestrians' lights */
+        APP_SetLamps( LED_BIT(LED_CAR_R) |
+                      LED_BIT(LED_PEDESTRIAN_R) );
+    }
+
+    if(APP_GetStateTimeMs() >= PREEMPT_ALL_RED_MS) {
+        APP_ChangeState(APP_STATE_PREEMPT_GREEN);
+    }
+}
+
+/*********************************************************************************
+ * @brief   Preempted green state
+ * @details This function is called when the system is in the preempted green 
+ *          state, it will turn on the cars' green light and pedestrian's red 
+ *          light, and turn off the other lights
+ *          The green is held for PREEMPT_MIN_GREEN_MS, then while the input is
+ *          low. The call is then served, and the cycle starts again from the
+ *          cars' green state, with the green already shown
+ * @param   void
+ * @return  void
+ ********************************************************************************/
+static void APP_PreemptGreenState(void) {
+    if(isStateEntry) {
+        isStateEntry = FALSE;
+
+        /* Configure the cars' and pedestrians' lights */
+        APP_SetLamps( LED_BIT(LED_CAR_G) |
+                      LED_BIT(LED_PEDESTRIAN_R) );
+    }
+
+    if( isPreemptHeld || (APP_GetStateTimeMs() < PREEMPT_MIN_GREEN_MS) ) {
+        return;
+    }
+
+    isPreemptCalled = FALSE;
+    APP_ChangeState(APP_STATE_CARS_GREEN);
+}
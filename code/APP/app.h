@@ -11,6 +11,52 @@
 #ifndef APP_H_
 #define APP_H_
 
+/*********************************************************************************
+ * @brief   Commands of the command link, the type byte of the frames, see 
+ *          \ref PROTOCOL_Init
+ * @details Each command is answered by a frame of type command | APP_REPLY_FLAG,
+ *          whose payload starts with an ERROR_t status byte. The rest of the 
+ *          reply is only sent with ERROR_OK. Values are little endian, with 
+ *          the packed structs and one byte enums of the build.
+ *              * GET_STATE: no payload. Reply: state, tick, tick of the state 
+ *                  start, pedestrian call and its tick, cars' call, 
+ *                  coordination, phase error (us), green adjust (ms), index 
+ *                  and times of the plan of the cycle, adaptive cycle and 
+ *                  cars' green (ms), 0 until computed
+ *              * GET_COUNTERS: no payload. Reply: cycles, pedestrian calls, 
+ *                  watchdog and brown-out resets, transit calls and the bus
+ *                  delay they saved (s) (EEPROM), cars' count, 
+ *                  pedestrian calls served since reset and their longest wait
+ *                  (ms), source of the last reset (WDT_RESET_t) and TRUE if
+ *                  the state was resumed after it, preemptions since reset
+ *                  and their longest latency (us), longest period of the 
+ *                  control loop since reset (us), preemptions and periods of
+ *                  the loop over PREEMPT_MAX_LATENCY_US
+ *              * GET_TRACE: no payload. Reply: up to APP_TRACE_RECORDS vehicles
+ *                  of the speed trap, oldest first, see \ref SPEED_RECORD_t
+ *              * GET_PLAN: plan index. Reply: plan index and times in use
+ *              * SET_PLAN: plan index, min green, passage and max green (ms). 
+ *                  Reply: plan index and staged times. ERROR_OUT_OF_RANGE if 
+ *                  the times break the guarantees checked for app_cfg.h, the
+ *                  min green floor and a passage of 0 included. The staged 
+ *                  plans are taken at the next cycle boundary
+ *              * SAVE_PLANS: no payload. Reply: status only. The staged plans
+ *                  are written in the EEPROM, and staged again at the next 
+ *                  reset. ERROR_BUSY if the EEPROM is writing
+ *              * SET_TIME: hours, minutes, seconds. Reply: status only
+ ********************************************************************************/
+typedef enum {
+    APP_COMMAND_GET_STATE       = 0x01,
+    APP_COMMAND_GET_COUNTERS    = 0x02,
+    APP_COMMAND_GET_TRACE       = 0x03,
+    APP_COMMAND_GET_PLAN        = 0x04,
+    APP_COMMAND_SET_PLAN        = 0x10,
+    APP_COMMAND_SET_TIME        = 0x11,
+    APP_COMMAND_SAVE_PLANS      = 0x12,
+} APP_COMMAND_t;
+
+#define APP_REPLY_FLAG      (0x80U)
+
 /*********************************************************************************
  * @brief   Initialize the application
  * @details Initialize the application by initializing the peripherals and
@@ -28,5 +74,48 @@ void APP_Init(void);
  ********************************************************************************/
 void APP_Start(void);
 
+/*********************************************************************************
+ * @brief   Get a percentile of the wait of the served pedestrian calls
+ * @details The waits are kept in bins of PED_WAIT_BIN_MS, the result is the 
+ *          upper edge of the bin, or the exact longest wait for percentile 100
+ * @param   percentile: 1 to 100, e.g. 50 for the median, 95 for the 95th
+ * @param   pWaitMs: the wait in milliseconds that percentile % of the calls 
+ *          did not exceed
+ * @return  ERROR_t: ERROR_NOK if no call was served yet. See \ref ERROR_t
+ ********************************************************************************/
+ERROR_t APP_GetPedestrianWaitPercentile(const u8_t percentile, u32_t * const pWaitMs);
+
+/*********************************************************************************
+ * @brief   Get the phase error of the coordinated cycle
+ * @details Measured at the start of each cars' green: the time from the point 
+ *          COORD_OFFSET_MS after a sync pulse, modulo COORD_CYCLE_MS
+ * @param   pErrorUs: the error in microseconds, positive when the green is late
+ * @return  ERROR_t: ERROR_NOK if the cycle is not coordinated. See \ref ERROR_t
+ ********************************************************************************/
+ERROR_t APP_GetPhaseErrorUs(s32_t * const pErrorUs);
+
+/*********************************************************************************
+ * @brief   Get the longest latency of the emergency preemption
+ * @details Measured for each call placed by an edge of the receiver: the time
+ *          from the EXTI_2 interrupt to the lamps of the first state of the
+ *          transition. Guaranteed below PREEMPT_MAX_LATENCY_US while the 
+ *          periods of the control loop are, the overruns of both are 
+ *          reported by GET_COUNTERS
+ * @param   pLatencyUs: the longest latency since reset, in microseconds
+ * @return  ERROR_t: ERROR_NOK if no call was timed yet. See \ref ERROR_t
+ ********************************************************************************/
+ERROR_t APP_GetPreemptLatencyUs(u32_t * const pLatencyUs);
+
+/*********************************************************************************
+ * @brief   Get the adaptive cycle and the cars' max green it gives
+ * @details Computed every ADAPT_UPDATE_CYCLES cycles from the detector volume,
+ *          the loop occupancy and the pedestrian phases served in the last 
+ *          ADAPT_WINDOW_CYCLES cycles
+ * @param   pCycleMs: the cycle, in milliseconds
+ * @param   pGreenMs: the cars' max green, in milliseconds
+ * @return  ERROR_t: ERROR_NOK if not computed yet. See \ref ERROR_t
+ ********************************************************************************/
+ERROR_t APP_GetAdaptiveCycle(u32_t * const pCycleMs, u32_t * const pGreenMs);
+
 
 #endif /* APP_H_ */
\ No newline at end of file
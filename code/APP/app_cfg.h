@@ -15,6 +15,223 @@
 /*!< Time delay in seconds for each state in the state machine. */
 #define STATE_TIME_SEC  ((u8_t)5)
 
+/*!< Same delay in milliseconds, the state machine runs on the 1 ms tick */
+#define STATE_TIME_MS   ((u32_t)STATE_TIME_SEC * 1000UL)
 
+/*!< Period of the yellow lights blinking */
+#define BLINK_TIME_MS   ((u32_t)1000)
 
-#endif /* APP_CFG_H_ */
\ No newline at end of file
+/*------------------------------------------------------------------------------*/
+/*                          Actuated cars' green                                */
+/*------------------------------------------------------------------------------*/
+
+/*!< Each timing plan sets, for the cars' green:
+       MIN_GREEN_MS: the green is always held for at least this time
+       PASSAGE_MS:   each actuation of the cars' detector extends the green up
+                     to this time, the green ends (gap-out) when no vehicle 
+                     arrives for this time
+       MAX_GREEN_MS: the green ends (max-out) after this time even with a 
+                     continuous demand
+     The plan is switched by the time of day schedule, see RTC_cfg.c. The night
+     flash plan has no green: the cars' yellow blinks, the pedestrians' lights
+     are off */
+
+/*!< Peak plan: long greens for the main flow */
+#define PEAK_MIN_GREEN_MS       ((u32_t)5000)
+#define PEAK_PASSAGE_MS         ((u32_t)2000)
+#define PEAK_MAX_GREEN_MS       ((u32_t)30000)
+
+/*!< Off-peak plan: shorter greens, the pedestrians wait less */
+#define OFF_PEAK_MIN_GREEN_MS   ((u32_t)5000)
+#define OFF_PEAK_PASSAGE_MS     ((u32_t)1500)
+#define OFF_PEAK_MAX_GREEN_MS   ((u32_t)15000)
+
+/*!< Shortest min green a plan may have, the plans of SET_PLAN and of the 
+     EEPROM included: a vehicle standing at the stop line must be able to 
+     start and clear it. The passage time of a plan must not be 0 */
+#define PLAN_MIN_GREEN_FLOOR_MS ((u32_t)4000)
+
+/*!< TRUE:  a call is placed on every red, the green is never skipped. To be used 
+            when the detector fails, or with MAX_GREEN_MS = MIN_GREEN_MS for a
+            fixed time operation
+     FALSE: the green is skipped and the cars rest in red until a vehicle comes */
+#define CARS_RECALL         FALSE
+
+/*------------------------------------------------------------------------------*/
+/*                          Pedestrian calls                                    */
+/*------------------------------------------------------------------------------*/
+
+/*!< A pedestrian call is always served within this time, except in the night
+     flash plan. Must be at least 2 * STATE_TIME_MS + the MIN_GREEN_MS of each
+     plan */
+#define PED_MAX_WAIT_MS     ((u32_t)30000)
+
+/*!< Resolution of the pedestrian wait percentiles */
+#define PED_WAIT_BIN_MS     ((u32_t)1000)
+
+
+/*------------------------------------------------------------------------------*/
+/*                          Coordination                                        */
+/*------------------------------------------------------------------------------*/
+
+/*!< TRUE:  while the corridor sync pulses come on EXTI_1, the cycle is phase 
+            locked to them: the cars' green is held to a fixed cycle, and 
+            stretched or shrunk to start COORD_OFFSET_MS after each pulse
+     FALSE: the sync pulses are ignored */
+#define COORD_ENABLE            TRUE
+
+/*!< Cycle of the corridor, the time between two sync pulses. The cars' green 
+     takes what is left by the yellow and red, or by the pedestrian's states */
+#define COORD_CYCLE_MS          ((u32_t)30000)
+
+/*!< Start of the cars' green after the sync pulse: the travel time from the 
+     first intersection of the corridor, for a green wave */
+#define COORD_OFFSET_MS         ((u32_t)0)
+
+/*!< The green is changed by at most this time in a cycle to correct the phase */
+#define COORD_MAX_ADJUST_MS     ((u32_t)3000)
+
+/*!< The cycle runs free, actuated, when no pulse came for this time */
+#define COORD_SYNC_TIMEOUT_MS   ((u32_t)3 * COORD_CYCLE_MS)
+
+
+/*------------------------------------------------------------------------------*/
+/*                          Adaptive cycle                                      */
+/*------------------------------------------------------------------------------*/
+
+/*!< TRUE:  the max green of the cars follows the demand. Each cycle, the cars' 
+            volume of the detector, the occupancy of loop A of the speed trap
+            and the pedestrian phases served are kept, over a rolling window
+            of ADAPT_WINDOW_CYCLES cycles. Every ADAPT_UPDATE_CYCLES cycles, 
+            the cycle of Webster, C = (1.5 L + 5 s) / (1 - Y), is computed 
+            from them in fixed point, and the cars' green is given what is
+            left by the lost time L. The green still gaps out when the demand
+            ends. Not in coordination: the corridor sets the cycle
+     FALSE: the plan's max green is used */
+#define ADAPT_ENABLE            TRUE
+
+/*!< Cycles of the rolling window, and cycles between two updates */
+#define ADAPT_WINDOW_CYCLES     (8U)
+#define ADAPT_UPDATE_CYCLES     (4U)
+
+/*!< Saturation headway: time a queue takes to discharge one vehicle. The flow
+     ratio Y of the cars is the share of time their count needs at this rate,
+     or the occupancy of the loop when a standing queue covers it longer */
+#define ADAPT_SAT_HEADWAY_MS    ((u32_t)2000)
+
+/*!< Y is kept below this, in 1/4096: C grows without bound when Y nears 1 */
+#define ADAPT_MAX_FLOW_RATIO    (3686U)
+
+/*!< Limits of the cycle, and the largest change of the green in one update. 
+     The green is never less than the min green of the plan */
+#define ADAPT_MIN_CYCLE_MS      ((u32_t)20000)
+#define ADAPT_MAX_CYCLE_MS      ((u32_t)60000)
+#define ADAPT_MAX_STEP_MS       ((u32_t)5000)
+
+
+/*------------------------------------------------------------------------------*/
+/*                          Transit signal priority                             */
+/*------------------------------------------------------------------------------*/
+
+/*!< TRUE:  the transit receiver, wired across key 'A' of the keypad, calls a 
+            priority for a bus on the main road. In the cars' green, the green
+            is extended until the bus is through. Otherwise the pedestrian's 
+            walk and the cars' red are cut short for an early green. Neither 
+            the yellow nor the pedestrian's clearance is ever cut
+     FALSE: the calls are ignored */
+#define TSP_ENABLE              TRUE
+
+/*!< Time of the bus from the receiver's check-in point through the stop line */
+#define TSP_TRAVEL_MS           ((u32_t)8000)
+
+/*!< Green extension: at most this time past the end the green would have had.
+     The extension also ends when a pedestrian reaches the limit of its wait */
+#define TSP_MAX_EXTEND_MS       ((u32_t)8000)
+
+/*!< Early green: the pedestrian's walk and the cars' red are cut down to these,
+     both at most STATE_TIME_MS */
+#define TSP_MIN_WALK_MS         ((u32_t)3000)
+#define TSP_MIN_RED_MS          ((u32_t)1000)
+
+/*!< Recovery: cycles served without priority after a served call, for the 
+     pedestrians and the coordination to catch up */
+#define TSP_LOCKOUT_CYCLES      (2U)
+
+
+/*------------------------------------------------------------------------------*/
+/*                          Emergency preemption                                */
+/*------------------------------------------------------------------------------*/
+
+/*!< TRUE:  a falling edge on EXTI_2, from the preemption receiver, calls the 
+            cars' green for an emergency vehicle on the main road. From any 
+            state, the yellow or the pedestrian's clearance in progress runs 
+            to its end, then the all red, then the green is held while the 
+            input is low. The loop takes the call at its next update, within
+            PREEMPT_MAX_LATENCY_US
+     FALSE: the input is ignored */
+#define PREEMPT_ENABLE          TRUE
+
+/*!< Latency of the preemption, from the edge to the lamps of the transition. 
+     A call is taken by the update after its edge, so it holds while the period
+     of the control loop stays below it. The periods and the calls over it are 
+     counted, see GET_COUNTERS. Worst case of an update, estimated at 16 MHz:
+        - EEPROM: the writes are queued, an add costs the copy of its 5 bytes, 
+            the EE_RDY ISR writes them: no wait for the 8.5 ms of a write
+        - TWI: the LCD and the keypad queue one transaction per update, the 
+            bus runs from its ISR. The LCD scans its 32 characters: < 0.05 ms
+        - Command link: the bytes received, up to 16, then the handler and its
+            reply of up to 61 bytes through the bitwise CRC: < 0.6 ms
+        - Adaptive cycle and restart copy: a few 32-bit divisions once per
+            cycle, a CRC of 16 bytes per change of state: < 0.3 ms
+        - SPI lamp backend: 4 bytes at F_CPU / 2: < 0.01 ms
+        - ISRs, mostly the tick callbacks every ms: < 10 % of the time
+     So < 1.5 ms, far from this bound */
+#define PREEMPT_MAX_LATENCY_US  ((u32_t)10000)
+
+/*!< All red before the preempted green, when the cars were not already in red 
+     for this time */
+#define PREEMPT_ALL_RED_MS      ((u32_t)2000)
+
+/*!< The preempted green lasts at least this time, a short pulse of the receiver
+     is enough to call it. The pedestrian wait guarantee is suspended meanwhile */
+#define PREEMPT_MIN_GREEN_MS    ((u32_t)10000)
+
+
+/*------------------------------------------------------------------------------*/
+/*                          Warm restart                                        */
+/*------------------------------------------------------------------------------*/
+
+/*!< TRUE:  after a watchdog or brown-out reset, the state, its elapsed time and 
+            the pending calls are taken back from a .noinit copy, when its CRC 
+            is right: the lamps are restored during the initialization
+     FALSE: every reset starts a new cycle */
+#define WARM_RESTART_ENABLE     TRUE
+
+/*!< Warm restarts in a row, with no cycle ended in between, before a cold start:
+     a fault that resets the controller in a state is not resumed forever */
+#define WARM_RESTART_MAX        (3U)
+
+
+/*------------------------------------------------------------------------------*/
+/*                          Status panel                                        */
+/*------------------------------------------------------------------------------*/
+
+/*!< The LCD is refreshed on each change of state, and at least this often for 
+     the clock */
+#define STATUS_REFRESH_MS       ((u32_t)250)
+
+
+/*------------------------------------------------------------------------------*/
+/*                          Command link                                        */
+/*------------------------------------------------------------------------------*/
+
+/*!< Vehicles of the speed trap sent in a GET_TRACE reply, see app.h. The reply 
+     must fit in PROTOCOL_MAX_TX_PAYLOAD */
+#define APP_TRACE_RECORDS       (4U)
+
+/*!< Plans saved by the SAVE_PLANS command, one record of 14 bytes per plan. 
+     Must not overlap the counters of EEPROM_cfg.c, from 0x040 */
+#define APP_PLANS_EEPROM_ADDRESS    ((u16_t)0x000)
+
+
+#endif /* APP_CFG_H_ */
@@ -29,6 +29,21 @@
 
 // #include "../HAL/LED/LED.h"
 // #include "../HAL/BUTTON/BUTTON.h"
+// #include "../HAL/COUNTER/COUNTER.h"
+// #include "../HAL/SPEED/SPEED.h"
+// #include "../MCAL/EEPROM/EEPROM.h"
+// #include "../MCAL/WDT/WDT.h"
+// #include "../HAL/MONITOR/MONITOR.h"
+// #include "../MCAL/ADC/ADC.h"
+// #include "../HAL/RTC/RTC.h"
+// #include "../MCAL/UART/UART.h"
+// #include "../HAL/FAILSAFE/FAILSAFE.h"
+// #include "../HAL/SSEG/SSEG.h"
+// #include "../HAL/TONE/TONE.h"
+// #include "../MCAL/TWI/TWI.h"
+// #include "../MCAL/SPI/SPI.h"
+// #include "../HAL/LCD/LCD.h"
+// #include "../HAL/KEYPAD/KEYPAD.h"
 
 // #include <util/delay.h>
 
@@ -44,6 +59,21 @@
 // static void test_LED(void);
 // static void test_BUTTON(void);
 // static void test_TIMER(void);
+// static void test_COUNTER(void);
+// static void test_SPEED(void);
+// static void test_EEPROM(void);
+// static void test_WDT(void);
+// static void test_MONITOR(void);
+// static void test_ADC(void);
+// static void test_RTC(void);
+// static void test_UART(void);
+// static void test_FAILSAFE(void);
+// static void test_SSEG(void);
+// static void test_TONE(void);
+// static void test_TWI(void);
+// static void test_SPI(void);
+// static void test_LCD(void);
+// static void test_KEYPAD(void);
 
 // static void EXTI_Notify(void);
 
@@ -78,6 +108,106 @@
 //     DIO_Init();
 //     LED_Init();
 //     test_TIMER();
+
+//     #elif 0     /* Test COUNTER */
+//     DIO_Init();
+//     LED_Init();
+//     COUNTER_Init();
+//     test_COUNTER();
+
+//     #elif 0     /* Test SPEED */
+//     DIO_Init();
+//     LED_Init();
+//     SPEED_Init();
+//     test_SPEED();
+
+//     #elif 0     /* Test EEPROM */
+//     DIO_Init();
+//     LED_Init();
+//     EEPROM_Init();
+//     test_EEPROM();
+
+//     #elif 0     /* Test WDT */
+//     DIO_Init();
+//     LED_Init();
+//     TIMER_TickInit();
+//     WDT_Init();
+//     test_WDT();
+
+//     #elif 0     /* Test MONITOR */
+//     DIO_Init();
+//     LED_Init();
+//     TIMER_TickInit();
+//     MONITOR_Init();
+//     test_MONITOR();
+
+//     #elif 0     /* Test ADC */
+//     DIO_Init();
+//     ADC_Init();
+//     LED_Init();
+//     TIMER_TickInit();
+//     LED_StartLampCheck();
+//     test_ADC();
+
+//     #elif 0     /* Test RTC */
+//     DIO_Init();
+//     LED_Init();
+//     TIMER_TickInit();
+//     RTC_Init();
+//     test_RTC();
+
+//     #elif 0     /* Test UART */
+//     DIO_Init();
+//     UART_Init();
+//     test_UART();
+
+//     #elif 0     /* Test FAILSAFE */
+//     DIO_Init();
+//     LED_Init();
+//     FAILSAFE_Init();
+//     test_FAILSAFE();
+
+//     #elif 0     /* Test SSEG */
+//     DIO_Init();
+//     TIMER_TickInit();
+//     SSEG_Init();
+//     GIE_Enable();
+//     test_SSEG();
+
+//     #elif 0     /* Test TONE */
+//     DIO_Init();
+//     TIMER_TickInit();
+//     TONE_Init();
+//     GIE_Enable();
+//     test_TONE();
+
+//     #elif 0     /* Test TWI */
+//     DIO_Init();
+//     LED_Init();
+//     TWI_Init();
+//     test_TWI();
+
+//     #elif 0     /* Test SPI */
+//     DIO_Init();
+//     SPI_Init();
+//     test_SPI();
+
+//     #elif 0     /* Test LCD */
+//     DIO_Init();
+//     TIMER_TickInit();
+//     TWI_Init();
+//     LCD_Init();
+//     GIE_Enable();
+//     test_LCD();
+
+//     #elif 0     /* Test KEYPAD */
+//     DIO_Init();
+//     LED_Init();
+//     TIMER_TickInit();
+//     TWI_Init();
+//     KEYPAD_Init();
+//     GIE_Enable();
+//     test_KEYPAD();
 //     #endif
 
 //     while(1) {
@@ -252,6 +382,247 @@
 //     LED_Set(LED_CAR_R);
 // }
 
+// static void test_COUNTER(void) {
+//     u32_t count = 0;
+
+//     while(1) {
+//         /* Car red follows bit 0 of the count, car green shows each 1 s snapshot */
+//         COUNTER_Read(COUNTER_CARS, &count);
+//         LED_SetClr(LED_CAR_R, count & 1);
+
+//         TIMER_DelayMs(1000);
+//         COUNTER_Snapshot(COUNTER_CARS, &count);
+//         LED_SetClr(LED_CAR_G, (count > 0));
+//     }
+// }
+
+// static void test_SPEED(void) {
+//     SPEED_RECORD_t vehicle;
+
+//     while(1) {
+//         /* Car green for vehicles over 50 km/h, car red otherwise */
+//         if(ERROR_OK == SPEED_Read(&vehicle)) {
+//             LED_SetClr(LED_CAR_G, (vehicle.speedKmhX10 > 500) ? HIGH : LOW);
+//             LED_SetClr(LED_CAR_R, (vehicle.speedKmhX10 > 500) ? LOW : HIGH);
+//         }
+//     }
+// }
+
+// static void test_EEPROM(void) {
+//     u32_t u32Resets = 0;
+//     u8_t u8Data = 0;
+
+//     /* Count the resets in a wear-leveled ring, the write does not block */
+//     EEPROM_CounterAdd(EEPROM_COUNTER_CYCLES, 1);
+//     EEPROM_CounterRead(EEPROM_COUNTER_CYCLES, &u32Resets);
+
+//     EEPROM_WriteByte(0x000, 0x5A);
+
+//     while(1) {
+//         /* Car green: the byte reads back, even before it is written */
+//         if(ERROR_OK == EEPROM_ReadByte(0x000, &u8Data)) {
+//             LED_SetClr(LED_CAR_G, (0x5A == u8Data) ? HIGH : LOW);
+//         }
+
+//         /* Car yellow: odd number of resets */
+//         LED_SetClr(LED_CAR_Y, (u32Resets & 1U) ? HIGH : LOW);
+
+//         /* Car red: writes still queued */
+//         LED_SetClr(LED_CAR_R, EEPROM_IsIdle() ? LOW : HIGH);
+//     }
+// }
+
+// static void test_WDT(void) {
+//     u32_t u32Start = 0;
+
+//     /* Car red: the last reset was caused by a missed check in */
+//     LED_SetClr(LED_CAR_R, (WDT_ACTIVITY_NONE != WDT_GetResetCause()) ? HIGH : LOW);
+
+//     /* Check in for 5 seconds, then hang: the MCU resets */
+//     u32Start = TIMER_GetTickMs();
+//     while( (TIMER_GetTickMs() - u32Start) < 5000UL ) {
+//         WDT_CheckIn(WDT_ACTIVITY_CONTROL_LOOP);
+//         WDT_CheckIn(WDT_ACTIVITY_INPUTS);
+//     }
+
+//     LED_Set(LED_CAR_Y);
+
+//     while(1) {
+//         WDT_CheckIn(WDT_ACTIVITY_INPUTS);
+//     }
+// }
+
+// static void test_MONITOR(void) {
+//     LED_SetImage(LED_BIT(LED_CAR_G) | LED_BIT(LED_PEDESTRIAN_R));
+//     TIMER_DelayMs(3000);
+
+//     /* Conflict: the monitor locks the LEDs and flashes the reds */
+//     LED_Set(LED_PEDESTRIAN_G);
+
+//     while(1) {
+//         /* Has no effect once locked */
+//         LED_Set(LED_CAR_G);
+//     }
+// }
+
+// static void test_ADC(void) {
+//     u16_t u16Millivolts = 0;
+//     u16_t u16Milliamps = 0;
+
+//     while(1) {
+//         /* Light the cars' red alone: its head current is the lamp current */
+//         LED_SetImage(LED_BIT(LED_CAR_R));
+//         TIMER_DelayMs(500);
+
+//         ADC_ReadMillivolts(ADC_CHANNEL_6, &u16Millivolts);
+//         LED_GetCurrent(LED_CAR_R, &u16Milliamps);
+
+//         /* Unplug the red lamp: the yellow lights after ~120 ms */
+//         if(LED_IsLampFault(LED_CAR_R)) {
+//             LED_SetImage(LED_BIT(LED_CAR_Y));
+//             while(1);
+//         }
+//     }
+// }
+
+// static void test_RTC(void) {
+//     RTC_TIME_t time = {22, 59, 55};
+
+//     /* 5 seconds before the night flash plan */
+//     RTC_SetTime(&time);
+
+//     while(1) {
+//         /* Cars' green in the day plans, cars' yellow in the night flash plan */
+//         if(RTC_PLAN_NIGHT_FLASH == RTC_GetPlan()) {
+//             LED_SetImage(LED_BIT(LED_CAR_Y));
+//         } else {
+//             LED_SetImage(LED_BIT(LED_CAR_G));
+//         }
+//     }
+// }
+
+// static void test_UART(void) {
+//     u8_t u8Byte = 0;
+
+//     /* Echo, 38400 8N1: the lines typed in a terminal come back */
+//     while(1) {
+//         if(ERROR_OK == UART_Receive(&u8Byte)) {
+//             UART_Send(&u8Byte, 1);
+//         }
+//     }
+// }
+
+// static void test_FAILSAFE(void) {
+//     LED_SetImage(LED_BIT(LED_CAR_G) | LED_BIT(LED_PEDESTRIAN_R));
+//     _delay_ms(2000);
+
+//     /* The green goes off and the flasher pin toggles every FAILSAFE_FLASH_MS, 
+//        then the CPU is parked with the interrupts disabled */
+//     FAILSAFE_Enter();
+
+//     /* Never reached */
+//     LED_SetImage(LED_BIT(LED_CAR_G));
+// }
+
+// static void test_SSEG(void) {
+//     u16_t u16Number = 0;
+
+//     /* Counts 0 to 99 twice a second, with no flicker, then blanks */
+//     for(u16Number = 0; u16Number <= 99; u16Number++) {
+//         SSEG_SetNumber(u16Number);
+//         _delay_ms(500);
+//     }
+
+//     SSEG_Clear();
+// }
+
+// static void test_TONE(void) {
+//     /* A beep each second, then the rapid tick, then silence */
+//     TONE_Play(TONE_LOCATOR);
+//     _delay_ms(5000);
+//     TONE_Play(TONE_WALK);
+//     _delay_ms(5000);
+//     TONE_Play(TONE_NONE);
+// }
+
+// static void test_TWI(void) {
+//     static const u8_t au8Register[1] = {0x00};
+//     static u8_t au8Seconds[1];
+//     static TWI_TRANSACTION_t transaction = {
+//         0x68, au8Register, 1, au8Seconds, 1, NULL, ERROR_OK
+//     };
+
+//     /* Reads the seconds of a DS1307 each second: the yellow blinks when it
+//        answers, the red when it does not */
+//     while(1) {
+//         if(ERROR_OK == TWI_Submit(&transaction)) {
+//             while(ERROR_BUSY == transaction.result) {
+//                 /* The control loop would run here */
+//             }
+
+//             LED_Toggle((ERROR_OK == transaction.result) ? LED_CAR_Y : LED_CAR_R);
+//         }
+//         _delay_ms(1000);
+//     }
+// }
+
+// static void test_SPI(void) {
+//     u8_t au8Frame[4] = {0, 0, 0, 0};
+//     u8_t i = 0;
+
+//     /* A lit output walks along a chain of four 74HC595, 5 per second */
+//     while(1) {
+//         for(i = 0; i < 32; i++) {
+//             au8Frame[3 - (i >> 3)] = (u8_t)(1U << (i & 7));
+
+//             SPI_Transfer(au8Frame, NULL, 4);
+//             DIO_SetPinValue(DIO_PINS_LAMPS_LATCH, HIGH);
+//             DIO_SetPinValue(DIO_PINS_LAMPS_LATCH, LOW);
+
+//             au8Frame[3 - (i >> 3)] = 0;
+//             _delay_ms(200);
+//         }
+//     }
+// }
+
+// static void test_LCD(void) {
+//     u32_t u32LastMs = 0;
+//     u8_t u8Seconds = 0;
+//     char acText[] = "00";
+
+//     /* A counter of seconds on the second row, the first row is sent once */
+//     LCD_Write(0, 0, "LCD TEST");
+
+//     while(1) {
+//         LCD_Update();
+
+//         if((TIMER_GetTickMs() - u32LastMs) >= 1000UL) {
+//             u32LastMs += 1000UL;
+//             u8Seconds = (u8Seconds + 1U) % 100U;
+//             acText[0] = (char)('0' + (u8Seconds / 10U));
+//             acText[1] = (char)('0' + (u8Seconds % 10U));
+//             LCD_Write(1, 0, acText);
+//         }
+//     }
+// }
+
+// static void test_KEYPAD(void) {
+//     KEYPAD_EVENT_t event;
+
+//     /* Key '1' toggles the cars' red, any other key toggles the cars' green */
+//     while(1) {
+//         KEYPAD_Update();
+
+//         if( (ERROR_OK == KEYPAD_GetEvent(&event)) && (TRUE == event.isPressed) ) {
+//             if('1' == event.key) {
+//                 LED_Toggle(LED_CAR_R);
+//             } else {
+//                 LED_Toggle(LED_CAR_G);
+//             }
+//         }
+//     }
+// }
+
 
 // static void EXTI_Notify(void) {
 //     DIO_TogglePort(DIO_PINS_CAR_LED_R);
@@ -0,0 +1,217 @@
+/**********************************************************************************
+ * @file        COUNTER.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Vehicle detector pulse counting in hardware (T0/T1 external clock)
+ * @version     1.0.0
+ * @date        2026-10-19
+ **********************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+#include "../../MCAL/TIMER/TIMER.h"
+#include "COUNTER.h"
+#include "COUNTER_cfg.h"
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            PRIVATE FUNCTIONS PROTOTYPES                      */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+static ERROR_t COUNTER_ReadIndex(const COUNTER_t counter, s8_t * const ptr_s8Index);
+static u32_t COUNTER_ReadTimer(const COUNTER_TIMER_t timer);
+static void COUNTER_Timer0Overflow(void);
+static void COUNTER_Timer1Overflow(void);
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            MACRO LIKE FUNCTIONS                              */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+#define ASSERT_COUNTER(counter)     ( counter < NUM_OF_COUNTERS )
+#define ASSERT_EDGE(edge)           ( (F_CPU_EXT_CLK_FALLING == edge) || (F_CPU_EXT_CLK_RISING == edge) )
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                           PRIVATE GLOBALS VARIABLES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< Overflows of each counting timer: the upper bits of the count      */
+static volatile u32_t COUNTER_overflows[NUM_OF_COUNTER_TIMERS];
+
+/*!< Count at the previous snapshot of each detector                    */
+static u32_t COUNTER_snapshotBase[NUM_OF_COUNTERS];
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PUBLIC FUNCTIONS                                */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+ERROR_t COUNTER_Init(void) {
+    ERROR_t error = ERROR_OK;
+    u8_t i = 0;
+
+    for(i = 0; i < countCountersConfigured; ++i) {
+        if( !ASSERT_COUNTER(countersConfigs[i].counter) || !ASSERT_EDGE(countersConfigs[i].edge) ) {
+            error |= ERROR_INVALID_PARAMETER;
+            continue;
+        }
+
+        COUNTER_snapshotBase[countersConfigs[i].counter] = 0;
+
+        switch(countersConfigs[i].timer) {
+            case COUNTER_TIMER_0:
+                COUNTER_overflows[COUNTER_TIMER_0] = 0;
+                TIMER0_Init(0, countersConfigs[i].edge, TIMER_MODE_NORMAL, NO_OC);
+                TIMER0_EnableOverflowInterrupt(COUNTER_Timer0Overflow);
+                break;
+            case COUNTER_TIMER_1:
+                COUNTER_overflows[COUNTER_TIMER_1] = 0;
+                TIMER1_Init(0, countersConfigs[i].edge, TIMER_MODE_NORMAL, NO_OC, TIMER_OCA);
+                TIMER1_EnableOverflowInterrupt(COUNTER_Timer1Overflow);
+                break;
+            default:
+                error |= ERROR_INVALID_PARAMETER;
+                break;
+        }
+    }
+
+    return error;
+}
+
+ERROR_t COUNTER_Read(const COUNTER_t counter, u32_t * const pCount) {
+    ERROR_t error = ERROR_OK;
+    s8_t i = 0;
+
+    if(NULL == pCount) {
+        return ERROR_NULL_POINTER;
+    }
+
+    error |= COUNTER_ReadIndex(counter, &i);
+    if(i < 0) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    *pCount = COUNTER_ReadTimer(countersConfigs[i].timer);
+
+    return error;
+}
+
+ERROR_t COUNTER_Snapshot(const COUNTER_t counter, u32_t * const pCount) {
+    ERROR_t error = ERROR_OK;
+    u32_t u32Now = 0;
+    s8_t i = 0;
+
+    if(NULL == pCount) {
+        return ERROR_NULL_POINTER;
+    }
+
+    error |= COUNTER_ReadIndex(counter, &i);
+    if(i < 0) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    u32Now = COUNTER_ReadTimer(countersConfigs[i].timer);
+
+    /* Unsigned difference stays right across the 32-bit wrap */
+    *pCount = u32Now - COUNTER_snapshotBase[counter];
+    COUNTER_snapshotBase[counter] = u32Now;
+
+    return error;
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PRIVATE FUNCTIONS                               */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief Get the index of the counter in the countersConfigs array
+ * 
+ * @param[in] counter: The counter to get the index of
+ * @param[in] ptr_s8Index: The pointer to the index of the counter. 
+ *              Options:
+ *                    -1: The counter is not in the countersConfigs array
+ *                  >= 0: The index of the counter in the countersConfigs array
+ * @return ERROR_t: The error status of the function.
+ ******************************************************************************/
+static ERROR_t COUNTER_ReadIndex(const COUNTER_t counter, s8_t * const ptr_s8Index) {
+    u8_t i = 0;
+
+    if(NULL == ptr_s8Index) {
+        return ERROR_NULL_POINTER;
+    }
+
+    *ptr_s8Index = -1;
+
+    if( !ASSERT_COUNTER(counter) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    for(i = 0; i < countCountersConfigured; ++i) {
+        if(counter == countersConfigs[i].counter) {
+            *ptr_s8Index = i;
+        }
+    }
+
+    return ERROR_OK;
+}
+
+/******************************************************************************
+ * @brief   Read the 32-bit count of a timer: software overflows + hardware count
+ * @details The read is retried if the overflow ISR ran in between. If the 
+ *          overflow is still pending (called with interrupts disabled) and the 
+ *          hardware count already wrapped, the pending overflow is added.
+ *          The timer reads do not touch the interrupts, so a caller's critical
+ *          section is kept to the end.
+ * @param[in] timer: the counting timer
+ * @return  u32_t: the extended count
+ ******************************************************************************/
+static u32_t COUNTER_ReadTimer(const COUNTER_TIMER_t timer) {
+    u32_t u32Overflows = 0;
+    u16_t u16Count = 0;
+    BOOL_t isOverflowPending = FALSE;
+
+    do {
+        u32Overflows = COUNTER_overflows[timer];
+
+        if(COUNTER_TIMER_0 == timer) {
+            u16Count = TIMER0_GetTimerValue();
+            isOverflowPending = TIMER0_IsOverflowPending();
+        } else {
+            u16Count = TIMER1_GetTimerValue();
+            isOverflowPending = TIMER1_IsOverflowPending();
+        }
+    } while(u32Overflows != COUNTER_overflows[timer]);
+
+    if(COUNTER_TIMER_0 == timer) {
+        if( isOverflowPending && (u16Count < 128U) ) {
+            ++u32Overflows;
+        }
+
+        return (u32Overflows << 8) | u16Count;
+    } else {
+        if( isOverflowPending && (u16Count < 32768U) ) {
+            ++u32Overflows;
+        }
+
+        return (u32Overflows << 16) | u16Count;
+    }
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              ISR CALLBACKS                                   */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< Every 256 pulses on T0  */
+static void COUNTER_Timer0Overflow(void) {
+    COUNTER_overflows[COUNTER_TIMER_0]++;
+}
+
+/*!< Every 65536 pulses on T1 */
+static void COUNTER_Timer1Overflow(void) {
+    COUNTER_overflows[COUNTER_TIMER_1]++;
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * @file        COUNTER.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref COUNTER.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef COUNTER_H
+#define COUNTER_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Vehicle detectors counted in hardware. Each one is wired to the 
+ *          external clock input (T0 or T1) of the timer set in COUNTER_cfg.c
+ *****************************************************************************/
+typedef enum {
+    COUNTER_CARS,
+
+    NUM_OF_COUNTERS
+}COUNTER_t;
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start counting the pulses of all configured detectors
+ * @details     The timer of each detector is clocked from its T0/T1 pin, so a 
+ *              vehicle costs no CPU time. Only the timer overflow interrupt
+ *              runs, once every 256 (Timer 0) or 65536 (Timer 1) vehicles, to 
+ *              extend the count to 32 bits.
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t COUNTER_Init(void);
+
+/******************************************************************************
+ * @brief       Read the number of pulses counted since \ref COUNTER_Init
+ * @param[in]   counter: the detector to read. See \ref COUNTER_t
+ * @param[out]  pCount: the 32-bit extended count (wraps around)
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t COUNTER_Read(const COUNTER_t counter, u32_t * const pCount);
+
+/******************************************************************************
+ * @brief       Take the count of the period that just ended and start a new one
+ * @details     The hardware counter is never stopped nor cleared, the period 
+ *              is restarted by moving its base. So no pulse is lost between 
+ *              two snapshots, whatever the flow.
+ * @param[in]   counter: the detector to read. See \ref COUNTER_t
+ * @param[out]  pCount: the pulses counted since the previous snapshot
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ * @par         Example:
+ *              @code
+ *              // Called once per cycle
+ *              COUNTER_Snapshot(COUNTER_CARS, &vehiclesInLastCycle);
+ *              @endcode
+ *****************************************************************************/
+ERROR_t COUNTER_Snapshot(const COUNTER_t counter, u32_t * const pCount);
+
+#endif      /* COUNTER_H */
@@ -0,0 +1,37 @@
+/******************************************************************************
+ * @file        COUNTER_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref COUNTER.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../MCAL/TIMER/TIMER.h"
+#include "COUNTER.h"
+#include "COUNTER_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*****************************************************************************
+ * @note    Each timer can count one detector only. The pin of the timer must
+ *          be configured as input in DIO_cfg.c (with pullup for open-collector
+ *          detector outputs).
+ *          Loop detector cards pull their output LOW while a vehicle is over 
+ *          the loop, so the falling edge counts one pulse per vehicle.
+ *****************************************************************************/
+COUNTER_CONFIGS_t countersConfigs[] = {
+    {COUNTER_CARS, COUNTER_TIMER_0, F_CPU_EXT_CLK_FALLING},
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     DO NOT CHANGE ANYTHING BELOW THIS LINE                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const u8_t countCountersConfigured = sizeof(countersConfigs) / sizeof(countersConfigs[0]);
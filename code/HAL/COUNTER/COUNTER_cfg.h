@@ -0,0 +1,43 @@
+/******************************************************************************
+ * @file        COUNTER_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref COUNTER.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef COUNTER_CFG_H
+#define COUNTER_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Timers that can count external pulses.
+ *          COUNTER_TIMER_0 counts on pin T0 (PB0), COUNTER_TIMER_1 on pin T1 (PB1)
+ *****************************************************************************/
+typedef enum {
+    COUNTER_TIMER_0,
+    COUNTER_TIMER_1,
+    NUM_OF_COUNTER_TIMERS
+}COUNTER_TIMER_t;
+
+/******************************************************************************
+ * @note    Members:
+ *          - counter:  The detector. See \ref COUNTER_t
+ *          - timer:    The timer counting its pulses
+ *          - edge:     F_CPU_EXT_CLK_FALLING or F_CPU_EXT_CLK_RISING
+ *****************************************************************************/
+typedef struct {
+    COUNTER_t           counter;
+    COUNTER_TIMER_t     timer;
+    TIMER_CLOCK_t       edge;
+}COUNTER_CONFIGS_t;
+
+extern COUNTER_CONFIGS_t countersConfigs[];
+extern const u8_t countCountersConfigured;
+
+#endif      /* COUNTER_CFG_H */
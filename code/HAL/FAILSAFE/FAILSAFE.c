@@ -0,0 +1,105 @@
+/**********************************************************************************
+ * @file        FAILSAFE.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Failsafe flash generated by a timer
+ * @details     The flashing lamps are driven by an output compare pin of Timer 1
+ *              in toggle mode, wired to their drivers, see FAILSAFE_cfg.h. Once
+ *              started, the flash only needs the CPU clock: no ISR, no loop.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **********************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+
+#include "../../MCAL/DIO/DIO.h"
+#include "../../MCAL/GIE/GIE.h"
+#include "../../MCAL/TIMER/TIMER.h"
+#include "../../MCAL/WDT/WDT.h"
+
+#include "FAILSAFE.h"
+#include "FAILSAFE_cfg.h"
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            MACRO LIKE FUNCTIONS                              */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< Timer 1 counts at F_CPU / 1024 and toggles the flasher every TOP + 1 counts */
+#define FAILSAFE_TOP            ( ((F_CPU / 1024UL) * FAILSAFE_FLASH_MS / 1000UL) - 1UL )
+
+#if (FAILSAFE_TOP > 65535UL) || (FAILSAFE_FLASH_MS < 1UL)
+#error "FAILSAFE_FLASH_MS is out of the range of Timer 1"
+#endif
+
+#if (FAILSAFE_FLASH == FAILSAFE_FLASH_YELLOW)
+#define FAILSAFE_OC             TIMER_OCA
+#elif (FAILSAFE_FLASH == FAILSAFE_FLASH_RED)
+#define FAILSAFE_OC             TIMER_OCB
+#else
+#error "FAILSAFE_FLASH is not defined"
+#endif
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                           PRIVATE GLOBALS VARIABLES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< Port register of the lamps, and their bits in it */
+static volatile u8_t * FAILSAFE_pPort = NULL;
+static u8_t FAILSAFE_lampMask = 0;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PUBLIC FUNCTIONS                                */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+ERROR_t FAILSAFE_Init(void) {
+    volatile u8_t * pLampPort = NULL;
+    volatile u8_t * pPort = NULL;
+    volatile u8_t * pPin = NULL;
+    u8_t u8Mask = 0;
+    u8_t u8Bit = 0;
+    u8_t i = 0;
+
+    for(i = 0; i < countFailsafeLamps; ++i) {
+        if(ERROR_OK != DIO_GetPinRegisters(failsafeLamps[i], &pPort, &pPin, &u8Bit)) {
+            return ERROR_INVALID_PARAMETER;
+        }
+
+        if( (0 != i) && (pPort != pLampPort) ) {
+            return ERROR_INVALID_PARAMETER;
+        }
+
+        pLampPort = pPort;
+        u8Mask |= u8Bit;
+    }
+
+    /* The entry is armed by the port, with its whole mask */
+    FAILSAFE_lampMask = u8Mask;
+    FAILSAFE_pPort = pLampPort;
+
+    return ERROR_OK;
+}
+
+ERROR_t FAILSAFE_Enter(void) {
+    if(NULL == FAILSAFE_pPort) {
+        return ERROR_NOT_INITIALIZED;
+    }
+
+    GIE_Disable();
+
+    *FAILSAFE_pPort &= (u8_t)~FAILSAFE_lampMask;
+
+    TIMER1_StartToggle((u16_t)FAILSAFE_TOP, FAILSAFE_OC);
+
+    WDT_Stop();
+
+    while(1) {
+        /* The flash runs in hardware, the CPU has nothing left to do */
+    }
+
+    return ERROR_OK;
+}
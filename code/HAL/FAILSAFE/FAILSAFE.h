@@ -0,0 +1,42 @@
+/******************************************************************************
+ * @file        FAILSAFE.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref FAILSAFE.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef FAILSAFE_H
+#define FAILSAFE_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Prepare the failsafe
+ * @details     Finds the register and the bits of the lamps once, so the entry
+ *              has nothing left to look up.
+ * @pre         \ref DIO_Init
+ * @return      ERROR_t: ERROR_INVALID_PARAMETER if the lamps are not all on 
+ *              the same port. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t FAILSAFE_Init(void);
+
+/******************************************************************************
+ * @brief       Give the lamps to the hardware flasher, until the next reset
+ * @details     Disables the interrupts, switches the lamps off, starts Timer 1
+ *              toggling the flasher pin (FAILSAFE_FLASH) and stops the 
+ *              watchdog, then parks the CPU. The flash needs no software: it 
+ *              goes on if the CPU is wedged afterwards. Straight line code, 
+ *              ~3 us at 16 MHz, from any context, ISRs included.
+ *              Timer 1 is taken from the speed trap.
+ * @return      ERROR_t: never returns, except ERROR_NOT_INITIALIZED before 
+ *              \ref FAILSAFE_Init. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t FAILSAFE_Enter(void);
+
+
+#endif      /* FAILSAFE_H */
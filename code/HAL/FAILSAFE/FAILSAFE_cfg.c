@@ -0,0 +1,39 @@
+/******************************************************************************
+ * @file        FAILSAFE_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref FAILSAFE.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../MCAL/DIO/DIO.h"
+#include "FAILSAFE.h"
+#include "FAILSAFE_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*****************************************************************************
+ * @note    Cleared in one write of the port: the flasher is then the only 
+ *          source of light.
+ *****************************************************************************/
+const DIO_PINS_t failsafeLamps[] = {
+    DIO_PINS_CAR_LED_R,
+    DIO_PINS_CAR_LED_Y,
+    DIO_PINS_CAR_LED_G,
+    DIO_PINS_PEDESTRIAN_LED_R,
+    DIO_PINS_PEDESTRIAN_LED_Y,
+    DIO_PINS_PEDESTRIAN_LED_G,
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     DO NOT CHANGE ANYTHING BELOW THIS LINE                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const u8_t countFailsafeLamps = sizeof(failsafeLamps) / sizeof(failsafeLamps[0]);
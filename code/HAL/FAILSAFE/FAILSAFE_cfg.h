@@ -0,0 +1,56 @@
+/******************************************************************************
+ * @file        FAILSAFE_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref FAILSAFE.c
+ * @details     Wiring: each lamp driver input is the OR (diodes or a gate) of
+ *              its DIO lamp pin and, for the flashed lamps, of a flasher pin:
+ *              - OC1A (PD5, DIO_PINS_FAILSAFE_YELLOW): the cars' yellow
+ *              - OC1B (PD4, DIO_PINS_FAILSAFE_RED): the cars' and the 
+ *                pedestrians' red
+ *              The flasher pins stay low in normal operation.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef FAILSAFE_CFG_H
+#define FAILSAFE_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              DO NOT CHANGE ANYTHING BELOW THIS COMMENT                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#define FAILSAFE_FLASH_YELLOW   0
+#define FAILSAFE_FLASH_RED      1
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    CHANGE THE FOLLOWING TO YOUR NEEDS                      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Lamps flashed by the failsafe
+ *          Options are:
+ *              FAILSAFE_FLASH_YELLOW --> cars' yellow, on OC1A
+ *              FAILSAFE_FLASH_RED    --> all red, on OC1B
+ ******************************************************************************/
+#define FAILSAFE_FLASH          FAILSAFE_FLASH_RED
+
+/******************************************************************************
+ * @brief   On and off time of the flashed lamps, up to 4194 ms
+ ******************************************************************************/
+#define FAILSAFE_FLASH_MS       (500UL)
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Lamps switched off by the failsafe, all on the same port */
+extern const DIO_PINS_t failsafeLamps[];
+extern const u8_t countFailsafeLamps;
+
+#endif      /* FAILSAFE_CFG_H */
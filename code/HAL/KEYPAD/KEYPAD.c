@@ -0,0 +1,206 @@
+/**********************************************************************************
+ * @file        KEYPAD.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       4x4 matrix keypad on a PCF8574, scanned one row per tick
+ * @details     The 16 keys are the bits of a u16_t, bit 4 * row + column. All
+ *              of them are debounced at once by vertical counters: bit i of 
+ *              KEYPAD_count0 and KEYPAD_count1 is a 2 bits counter of the 
+ *              scans in a row where key i read another level than its 
+ *              debounced state. A key changes after 4 such scans, 16 ms, and 
+ *              its counter is reset by any scan that agrees. The cost is a 
+ *              few logic operations per scan, whatever the number of keys.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **********************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+
+#include "../../MCAL/TIMER/TIMER.h"
+#include "../../MCAL/TWI/TWI.h"
+
+#include "KEYPAD.h"
+#include "KEYPAD_cfg.h"
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            PRIVATE FUNCTIONS PROTOTYPES                      */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+static void KEYPAD_Debounce(void);
+static void KEYPAD_PutEvent(const u8_t key, const BOOL_t isPressed);
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            MACRO LIKE FUNCTIONS                              */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+#define KEYPAD_QUEUE_MASK       ( KEYPAD_QUEUE_SIZE - 1U )
+
+#if (KEYPAD_QUEUE_SIZE & KEYPAD_QUEUE_MASK) || (KEYPAD_QUEUE_SIZE > 128U)
+#error "KEYPAD_QUEUE_SIZE must be a power of 2, up to 128"
+#endif
+
+#define KEYPAD_ROWS_MASK        ( (u8_t)(0x0FU << KEYPAD_ROW0_PIN) )
+#define KEYPAD_COLS_MASK        ( (u8_t)(0x0FU << KEYPAD_COL0_PIN) )
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                           PRIVATE GLOBALS VARIABLES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< The scan of a row: the port written, the selected row low and the columns 
+     high to be read, then the port read back */
+static u8_t KEYPAD_select = 0;
+static u8_t KEYPAD_port = 0;
+static TWI_TRANSACTION_t KEYPAD_transaction = {
+    KEYPAD_TWI_ADDRESS, &KEYPAD_select, 1, &KEYPAD_port, 1, NULL, ERROR_OK
+};
+
+/*!< Row of the transaction on the bus, and TRUE until its columns are taken */
+static u8_t KEYPAD_row = 0;
+static BOOL_t KEYPAD_isScanning = FALSE;
+
+/*!< Keys read pressed by the scan in progress, and the debounced keys */
+static u16_t KEYPAD_raw = 0;
+static u16_t KEYPAD_keys = 0;
+
+/*!< Vertical counters, see the file details */
+static u16_t KEYPAD_count0 = 0xFFFFU;
+static u16_t KEYPAD_count1 = 0xFFFFU;
+
+/*!< Event queue: written and read from the loop of the application only */
+static KEYPAD_EVENT_t KEYPAD_queue[KEYPAD_QUEUE_SIZE];
+static u8_t KEYPAD_head = 0;
+static u8_t KEYPAD_tail = 0;
+
+/*!< No row twice in the tick of lastMs */
+static u32_t KEYPAD_lastMs = 0;
+
+static BOOL_t KEYPAD_isStarted = FALSE;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PUBLIC FUNCTIONS                                */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+ERROR_t KEYPAD_Init(void) {
+    KEYPAD_row = 0;
+    KEYPAD_isScanning = FALSE;
+    KEYPAD_raw = 0;
+    KEYPAD_keys = 0;
+    KEYPAD_count0 = 0xFFFFU;
+    KEYPAD_count1 = 0xFFFFU;
+    KEYPAD_head = 0;
+    KEYPAD_tail = 0;
+    KEYPAD_lastMs = TIMER_GetTickMs();
+
+    KEYPAD_isStarted = TRUE;
+
+    return ERROR_OK;
+}
+
+void KEYPAD_Update(void) {
+    const u32_t u32NowMs = TIMER_GetTickMs();
+    u8_t u8Columns = 0;
+
+    if( (FALSE == KEYPAD_isStarted) || (ERROR_BUSY == KEYPAD_transaction.result) ) {
+        return;
+    }
+
+    if(KEYPAD_isScanning) {
+        KEYPAD_isScanning = FALSE;
+
+        /* A pressed key pulls its column low, no answer is no key */
+        if(ERROR_OK == KEYPAD_transaction.result) {
+            u8Columns = (u8_t)((u8_t)~KEYPAD_port & KEYPAD_COLS_MASK) >> KEYPAD_COL0_PIN;
+        }
+
+        KEYPAD_raw |= (u16_t)u8Columns << (KEYPAD_row * KEYPAD_COLS);
+
+        KEYPAD_row++;
+        if(KEYPAD_row >= KEYPAD_ROWS) {
+            KEYPAD_row = 0;
+            KEYPAD_Debounce();
+            KEYPAD_raw = 0;
+        }
+    }
+
+    if(u32NowMs == KEYPAD_lastMs) {
+        return;
+    }
+
+    KEYPAD_select = (u8_t)~(1U << (KEYPAD_ROW0_PIN + KEYPAD_row));
+
+    if(ERROR_OK == TWI_Submit(&KEYPAD_transaction)) {
+        KEYPAD_isScanning = TRUE;
+        KEYPAD_lastMs = u32NowMs;
+    }
+}
+
+ERROR_t KEYPAD_GetEvent(KEYPAD_EVENT_t * const pEvent) {
+    if(NULL == pEvent) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(KEYPAD_tail == KEYPAD_head) {
+        return ERROR_NOK;
+    }
+
+    *pEvent = KEYPAD_queue[KEYPAD_tail];
+    KEYPAD_tail = (u8_t)(KEYPAD_tail + 1U) & KEYPAD_QUEUE_MASK;
+
+    return ERROR_OK;
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PRIVATE FUNCTIONS                               */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Debounce the 16 keys of a whole scan, and queue their changes
+ * @details The counters of the keys that agree with their debounced state are
+ *          set to 3, the others count down. A key toggles when its counter 
+ *          goes from 0 back to 3
+ ******************************************************************************/
+static void KEYPAD_Debounce(void) {
+    u16_t u16Changed = KEYPAD_raw ^ KEYPAD_keys;
+    u8_t i = 0;
+
+    KEYPAD_count0 = (u16_t)~(KEYPAD_count0 & u16Changed);
+    KEYPAD_count1 = KEYPAD_count0 ^ (KEYPAD_count1 & u16Changed);
+
+    u16Changed &= KEYPAD_count0 & KEYPAD_count1;
+
+    if(0 == u16Changed) {
+        return;
+    }
+
+    KEYPAD_keys ^= u16Changed;
+
+    for(i = 0; i < (KEYPAD_ROWS * KEYPAD_COLS); ++i) {
+        if(0 != (u16Changed & (1U << i))) {
+            KEYPAD_PutEvent(i, (0 != (KEYPAD_keys & (1U << i))) ? TRUE : FALSE);
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief   Queue an event, dropped if the queue is full
+ * @param   key: bit of the key, 4 * row + column
+ * @param   isPressed: its new state
+ ******************************************************************************/
+static void KEYPAD_PutEvent(const u8_t key, const BOOL_t isPressed) {
+    u8_t u8Next = (u8_t)(KEYPAD_head + 1U) & KEYPAD_QUEUE_MASK;
+
+    if(u8Next == KEYPAD_tail) {
+        return;
+    }
+
+    KEYPAD_queue[KEYPAD_head].key = keypadKeys[key / KEYPAD_COLS][key % KEYPAD_COLS];
+    KEYPAD_queue[KEYPAD_head].isPressed = isPressed;
+    KEYPAD_head = u8Next;
+}
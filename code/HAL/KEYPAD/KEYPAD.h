@@ -0,0 +1,63 @@
+/******************************************************************************
+ * @file        KEYPAD.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref KEYPAD.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef KEYPAD_H
+#define KEYPAD_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   A key pressed or released
+ * @details - key:          its character, see KEYPAD_cfg.c
+ *          - isPressed:    TRUE when pressed, FALSE when released
+ ******************************************************************************/
+typedef struct {
+    char    key;
+    BOOL_t  isPressed;
+}KEYPAD_EVENT_t;
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the scan of the keypad, all keys released
+ * @pre         TWI_Init and TIMER_TickInit
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t KEYPAD_Init(void);
+
+/******************************************************************************
+ * @brief       Scan the next row
+ * @details     Never blocks, to be polled. At most one row per tick: one TWI 
+ *              transaction writes the row select and reads the columns back. 
+ *              After the last row, all the keys are debounced at once, and 
+ *              each key that changed queues an event. A keypad that does not 
+ *              answer reads as no key pressed.
+ * @return      void
+ *****************************************************************************/
+void KEYPAD_Update(void);
+
+/******************************************************************************
+ * @brief       Take the oldest event
+ * @details     Never blocks. The events of a full queue are dropped.
+ * @param[out]  pEvent: the event
+ * @return      ERROR_t: ERROR_OK if an event was read, ERROR_NOK if the queue
+ *              is empty. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t KEYPAD_GetEvent(KEYPAD_EVENT_t * const pEvent);
+
+
+#endif      /* KEYPAD_H */
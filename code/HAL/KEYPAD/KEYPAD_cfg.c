@@ -0,0 +1,24 @@
+/******************************************************************************
+ * @file        KEYPAD_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref KEYPAD.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "KEYPAD.h"
+#include "KEYPAD_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const char keypadKeys[KEYPAD_ROWS][KEYPAD_COLS] = {
+    {'1', '2', '3', 'A'},
+    {'4', '5', '6', 'B'},
+    {'7', '8', '9', 'C'},
+    {'*', '0', '#', 'D'},
+};
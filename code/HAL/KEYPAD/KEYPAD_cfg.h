@@ -0,0 +1,44 @@
+/******************************************************************************
+ * @file        KEYPAD_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref KEYPAD.c
+ * @details     Wiring: a 4x4 matrix keypad on a PCF8574 on the TWI bus. The 
+ *              rows on 4 pins driven low one at a time, the columns on the 4 
+ *              other pins, held high by the weak pullups of the PCF8574: a 
+ *              pressed key pulls its column low while its row is selected.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef KEYPAD_CFG_H
+#define KEYPAD_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< 7 bits address of the PCF8574, another one than the LCD's */
+#define KEYPAD_TWI_ADDRESS      (0x20U)
+
+/*!< Pin of row 0, rows 1 to 3 follow it, and of column 0 likewise */
+#define KEYPAD_ROW0_PIN         (0U)
+#define KEYPAD_COL0_PIN         (4U)
+
+/*!< Events waiting for the application, a power of 2. One entry stays unused */
+#define KEYPAD_QUEUE_SIZE       (8U)
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#define KEYPAD_ROWS             (4U)
+#define KEYPAD_COLS             (4U)
+
+/*!< Character of each key, by row then column */
+extern const char keypadKeys[KEYPAD_ROWS][KEYPAD_COLS];
+
+#endif      /* KEYPAD_CFG_H */
@@ -0,0 +1,335 @@
+/**********************************************************************************
+ * @file        LCD.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       HD44780 character LCD on a PCF8574, never blocking
+ * @details     The application writes a shadow of the screen in RAM. The LCD 
+ *              is polled: each tick, one nibble of the next character that 
+ *              differs from the screen goes out as a queued TWI transaction,
+ *              with a set of the address first when the character does not 
+ *              follow the last one written. A screen that does not change 
+ *              costs one scan of the shadow per poll, and no bus traffic.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **********************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+
+#include "../../MCAL/TIMER/TIMER.h"
+#include "../../MCAL/TWI/TWI.h"
+
+#include "LCD.h"
+#include "LCD_cfg.h"
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                                  TYPEDEFS                                    */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   A step of the initialization
+ * @details - value:        the byte, only its high nibble if isNibble
+ *          - isNibble:     the LCD is still in 8 bits mode
+ *          - waitMs:       before the next step
+ ******************************************************************************/
+typedef struct {
+    u8_t    value;
+    BOOL_t  isNibble;
+    u8_t    waitMs;
+}LCD_INIT_STEP_t;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            PRIVATE FUNCTIONS PROTOTYPES                      */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+static void LCD_Restart(const u32_t nowMs);
+static ERROR_t LCD_SendNibble(const u8_t nibble, const BOOL_t isData);
+static u8_t LCD_FindChange(void);
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            MACRO LIKE FUNCTIONS                              */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+#if (LCD_ROWS > 4U) || (LCD_COLS > 20U)
+#error "LCD_ROWS and LCD_COLS must be up to 4 and 20"
+#endif
+
+#define LCD_SIZE                ( LCD_ROWS * LCD_COLS )
+
+/*!< LCD_address and LCD_FindChange when there is no position */
+#define LCD_NO_POSITION         (0xFFU)
+
+/*!< From the power up to the first step, 40 ms once VCC reaches 4.5 V */
+#define LCD_POWER_UP_MS         (50UL)
+
+/*!< Commands of the HD44780 */
+#define LCD_CMD_CLEAR           (0x01U)
+#define LCD_CMD_ENTRY_INC       (0x06U)
+#define LCD_CMD_DISPLAY_OFF     (0x08U)
+#define LCD_CMD_DISPLAY_ON      (0x0CU)
+#define LCD_CMD_8_BITS          (0x30U)
+#define LCD_CMD_4_BITS          (0x20U)
+#define LCD_CMD_4_BITS_2_LINES  (0x28U)
+#define LCD_CMD_SET_ADDRESS     (0x80U)
+
+#define LCD_PIN_MASK(pin)       ( (u8_t)(1U << (pin)) )
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                           PRIVATE GLOBALS VARIABLES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< The 8 bits mode is set 3 times: the LCD is in a known mode from any state,
+     even in the middle of a byte of the 4 bits mode. The waits count from the
+     tick of the last nibble of the step, one more than the delay for the tick
+     of the transaction itself */
+static const LCD_INIT_STEP_t LCD_initSteps[] = {
+    {LCD_CMD_8_BITS,            TRUE,   6},     /* 4.1 ms */
+    {LCD_CMD_8_BITS,            TRUE,   1},     /* 100 us */
+    {LCD_CMD_8_BITS,            TRUE,   1},
+    {LCD_CMD_4_BITS,            TRUE,   1},
+    {LCD_CMD_4_BITS_2_LINES,    FALSE,  1},
+    {LCD_CMD_DISPLAY_OFF,       FALSE,  1},
+    {LCD_CMD_CLEAR,             FALSE,  3},     /* 1.52 ms */
+    {LCD_CMD_ENTRY_INC,         FALSE,  1},
+    {LCD_CMD_DISPLAY_ON,        FALSE,  1},
+};
+
+#define LCD_INIT_STEPS          ( sizeof(LCD_initSteps) / sizeof(LCD_initSteps[0]) )
+
+/*!< Address of the first character of each row */
+static const u8_t LCD_rowAddresses[4] = {0x00, 0x40, 0x14, 0x54};
+
+/*!< What the application wants, and what the LCD shows */
+static char LCD_shadow[LCD_SIZE];
+static char LCD_screen[LCD_SIZE];
+
+/*!< The nibble on the bus: the byte of E high, then of E low */
+static u8_t LCD_bytes[2];
+static TWI_TRANSACTION_t LCD_transaction = {
+    LCD_TWI_ADDRESS, LCD_bytes, sizeof(LCD_bytes), NULL, 0, NULL, ERROR_OK
+};
+
+/*!< The byte being sent, its low nibble is still to send, and the wait of 
+     its step once sent */
+static u8_t LCD_byte = 0;
+static BOOL_t LCD_isData = FALSE;
+static BOOL_t LCD_isLowPending = FALSE;
+static u8_t LCD_waitMs = 0;
+
+/*!< Next step of the initialization, LCD_INIT_STEPS once done */
+static u8_t LCD_initStep = LCD_INIT_STEPS;
+
+/*!< Position of the address counter of the LCD, or LCD_NO_POSITION */
+static u8_t LCD_address = LCD_NO_POSITION;
+
+/*!< No nibble before readyMs, nor twice in the tick of lastMs */
+static u32_t LCD_readyMs = 0;
+static u32_t LCD_lastMs = 0;
+
+static BOOL_t LCD_isStarted = FALSE;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PUBLIC FUNCTIONS                                */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+ERROR_t LCD_Init(void) {
+    LCD_Clear();
+    LCD_Restart(TIMER_GetTickMs());
+
+    LCD_isStarted = TRUE;
+
+    return ERROR_OK;
+}
+
+void LCD_Update(void) {
+    const u32_t u32NowMs = TIMER_GetTickMs();
+    const LCD_INIT_STEP_t * pStep = NULL;
+    u8_t u8Position = 0;
+    u8_t u8Byte = 0;
+    BOOL_t isData = FALSE;
+
+    if( (FALSE == LCD_isStarted) || (ERROR_BUSY == LCD_transaction.result) ) {
+        return;
+    }
+
+    if(ERROR_NOK == LCD_transaction.result) {
+        LCD_Restart(u32NowMs);
+        return;
+    }
+
+    if( (u32NowMs == LCD_lastMs) || ((s32_t)(u32NowMs - LCD_readyMs) < 0) ) {
+        return;
+    }
+
+    if(LCD_isLowPending) {
+        if(ERROR_OK == LCD_SendNibble(LCD_byte, LCD_isData)) {
+            LCD_isLowPending = FALSE;
+            LCD_readyMs = u32NowMs + LCD_waitMs;
+            LCD_waitMs = 0;
+            LCD_lastMs = u32NowMs;
+        }
+        return;
+    }
+
+    if(LCD_initStep < LCD_INIT_STEPS) {
+        pStep = &LCD_initSteps[LCD_initStep];
+
+        if(ERROR_OK == LCD_SendNibble((u8_t)(pStep->value >> 4), FALSE)) {
+            LCD_byte = pStep->value;
+            LCD_isData = FALSE;
+            LCD_lastMs = u32NowMs;
+
+            /* The wait starts with the last nibble of the step */
+            if(pStep->isNibble) {
+                LCD_readyMs = u32NowMs + pStep->waitMs;
+            } else {
+                LCD_isLowPending = TRUE;
+                LCD_waitMs = pStep->waitMs;
+            }
+            LCD_initStep++;
+        }
+        return;
+    }
+
+    u8Position = LCD_FindChange();
+    if(LCD_NO_POSITION == u8Position) {
+        return;
+    }
+
+    if(u8Position != LCD_address) {
+        u8Byte = LCD_CMD_SET_ADDRESS | (u8_t)(LCD_rowAddresses[u8Position / LCD_COLS] + (u8Position % LCD_COLS));
+        isData = FALSE;
+    } else {
+        u8Byte = (u8_t)LCD_shadow[u8Position];
+        isData = TRUE;
+    }
+
+    if(ERROR_OK != LCD_SendNibble((u8_t)(u8Byte >> 4), isData)) {
+        return;
+    }
+
+    LCD_byte = u8Byte;
+    LCD_isData = isData;
+    LCD_isLowPending = TRUE;
+    LCD_lastMs = u32NowMs;
+
+    if(isData) {
+        LCD_screen[u8Position] = (char)u8Byte;
+
+        /* The address counter does not go from a row to the next one */
+        u8Position++;
+        LCD_address = (0 == (u8Position % LCD_COLS)) ? LCD_NO_POSITION : u8Position;
+    } else {
+        LCD_address = u8Position;
+    }
+}
+
+ERROR_t LCD_Write(const u8_t row, const u8_t col, const char * const pText) {
+    u8_t u8Position = 0;
+    u8_t u8End = 0;
+    u8_t i = 0;
+
+    if(NULL == pText) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if( (row >= LCD_ROWS) || (col >= LCD_COLS) ) {
+        return ERROR_OUT_OF_RANGE;
+    }
+
+    u8Position = (u8_t)(row * LCD_COLS) + col;
+    u8End = (u8_t)(row * LCD_COLS) + LCD_COLS;
+
+    for(i = 0; ('\0' != pText[i]) && (u8Position < u8End); ++i) {
+        LCD_shadow[u8Position] = pText[i];
+        u8Position++;
+    }
+
+    return ERROR_OK;
+}
+
+void LCD_Clear(void) {
+    u8_t i = 0;
+
+    for(i = 0; i < LCD_SIZE; ++i) {
+        LCD_shadow[i] = ' ';
+    }
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PRIVATE FUNCTIONS                               */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Initialize the LCD again, and write the whole shadow after
+ * @param   nowMs: the tick
+ ******************************************************************************/
+static void LCD_Restart(const u32_t nowMs) {
+    u8_t i = 0;
+
+    /* No character of the shadow is '\0': all of them differ */
+    for(i = 0; i < LCD_SIZE; ++i) {
+        LCD_screen[i] = '\0';
+    }
+
+    LCD_initStep = 0;
+    LCD_isLowPending = FALSE;
+    LCD_waitMs = 0;
+    LCD_address = LCD_NO_POSITION;
+    LCD_readyMs = nowMs + LCD_POWER_UP_MS;
+
+    /* The failure is handled, the transaction is not queued */
+    LCD_transaction.result = ERROR_OK;
+}
+
+/******************************************************************************
+ * @brief   Queue the transaction of a nibble
+ * @param   nibble: in the low 4 bits
+ * @param   isData: RS high for a character, low for a command
+ * @return  ERROR_t: ERROR_BUSY if the TWI queue is full, to be sent again
+ ******************************************************************************/
+static ERROR_t LCD_SendNibble(const u8_t nibble, const BOOL_t isData) {
+    u8_t u8Port = (u8_t)((nibble & 0x0FU) << LCD_D4_PIN) | LCD_PIN_MASK(LCD_BACKLIGHT_PIN);
+
+    if(isData) {
+        u8Port |= LCD_PIN_MASK(LCD_RS_PIN);
+    }
+
+    /* The nibble is taken on the falling edge of E */
+    LCD_bytes[0] = u8Port | LCD_PIN_MASK(LCD_E_PIN);
+    LCD_bytes[1] = u8Port;
+
+    return TWI_Submit(&LCD_transaction);
+}
+
+/******************************************************************************
+ * @brief   Find a character of the shadow not on the screen
+ * @details From the address counter of the LCD, so that a changed text goes 
+ *          out with no set of the address between its characters
+ * @return  u8_t: its position, LCD_NO_POSITION if the screen is up to date
+ ******************************************************************************/
+static u8_t LCD_FindChange(void) {
+    u8_t u8Position = (LCD_NO_POSITION == LCD_address) ? 0 : LCD_address;
+    u8_t i = 0;
+
+    for(i = 0; i < LCD_SIZE; ++i) {
+        if(LCD_shadow[u8Position] != LCD_screen[u8Position]) {
+            return u8Position;
+        }
+
+        u8Position++;
+        if(u8Position >= LCD_SIZE) {
+            u8Position = 0;
+        }
+    }
+
+    return LCD_NO_POSITION;
+}
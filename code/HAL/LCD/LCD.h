@@ -0,0 +1,58 @@
+/******************************************************************************
+ * @file        LCD.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref LCD.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef LCD_H
+#define LCD_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the LCD, blank
+ * @details     Never blocks: the initialization sequence of the HD44780 and its
+ *              delays are run by \ref LCD_Update, like the writes.
+ * @pre         TWI_Init and TIMER_TickInit
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t LCD_Init(void);
+
+/******************************************************************************
+ * @brief       Send the next nibble to the LCD
+ * @details     Never blocks, to be polled. Sends at most one nibble per tick,
+ *              in a TWI transaction of 2 bytes that pulses E: the command 
+ *              delays of the HD44780 are always met. Only the characters that 
+ *              differ between the screen and the shadow are sent. A nibble not
+ *              acknowledged restarts the LCD, a screen plugged again is 
+ *              written whole.
+ * @return      void
+ *****************************************************************************/
+void LCD_Update(void);
+
+/******************************************************************************
+ * @brief       Write a text in the shadow of the screen
+ * @details     Only writes RAM, the screen follows within one tick per nibble.
+ *              The text is cut at the end of the row.
+ * @param[in]   row: 0 to LCD_ROWS - 1
+ * @param[in]   col: 0 to LCD_COLS - 1
+ * @param[in]   pText: the characters, ended by '\0'
+ * @return      ERROR_t: ERROR_OUT_OF_RANGE if the position is not on the 
+ *              screen. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t LCD_Write(const u8_t row, const u8_t col, const char * const pText);
+
+/******************************************************************************
+ * @brief       Blank the shadow of the screen
+ * @return      void
+ *****************************************************************************/
+void LCD_Clear(void);
+
+
+#endif      /* LCD_H */
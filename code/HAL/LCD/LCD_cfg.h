@@ -0,0 +1,39 @@
+/******************************************************************************
+ * @file        LCD_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref LCD.c
+ * @details     Wiring: a HD44780 character LCD in 4 bits mode behind a PCF8574
+ *              on the TWI bus, as on the usual "I2C backpack": the pins of the
+ *              PCF8574 drive D4..D7, RS, E and the backlight. RW is held low, 
+ *              the LCD is never read.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef LCD_CFG_H
+#define LCD_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< 7 bits address of the PCF8574: 0x20 to 0x27, or 0x38 to 0x3F for the 
+     PCF8574A */
+#define LCD_TWI_ADDRESS         (0x27U)
+
+/*!< Size of the screen, up to 4 rows of 20 characters */
+#define LCD_ROWS                (2U)
+#define LCD_COLS                (16U)
+
+/*!< Pins of the PCF8574 */
+#define LCD_RS_PIN              (0U)
+#define LCD_RW_PIN              (1U)
+#define LCD_E_PIN               (2U)
+#define LCD_BACKLIGHT_PIN       (3U)
+
+/*!< Pin of D4, D5 to D7 follow it */
+#define LCD_D4_PIN              (4U)
+
+#endif      /* LCD_CFG_H */
@@ -8,6 +8,10 @@
 #include "../../LIB/STD_TYPES.h"
 #include "../../LIB/BIT_MATH.h"
 #include "../../MCAL/DIO/DIO.h"
+#include "../../MCAL/GIE/GIE.h"
+#include "../../MCAL/ADC/ADC.h"
+#include "../../MCAL/TIMER/TIMER.h"
+#include "../../MCAL/SPI/SPI.h"
 #include "LED.h"
 #include "LED_cfg.h"
 
@@ -17,6 +21,13 @@
 /*                                                                              */
 /*------------------------------------------------------------------------------*/
 static ERROR_t LED_ReadIndex(const LED_t led, s8_t * const ptr_s8Index);
+static ERROR_t LED_ReadMilliamps(const ADC_CHANNEL_t channel, u16_t * const pMilliamps);
+static void LED_CheckLamps(void);
+static ERROR_t LED_WriteLamp(const u8_t i, const STATE_t state);
+static ERROR_t LED_ReadLamp(const u8_t i, STATE_t * const pState);
+#if (LED_BACKEND == LED_BACKEND_SR595)
+static void LED_ShiftFrame(void);
+#endif
 
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
@@ -25,6 +36,58 @@ static ERROR_t LED_ReadIndex(const LED_t led, s8_t * const ptr_s8Index);
 /*------------------------------------------------------------------------------*/
 #define ASSERT_LED(led)         ( led < NUM_OF_LEDS )
 
+#if (LED_BACKEND == LED_BACKEND_SR595)
+
+/*!< Byte and bit of the frame for an index of ledConfigs. The last register 
+     of the chain is shifted first */
+#define LED_FRAME_BYTE(i)       ( LED_frame[LED_CHAIN_BYTES - 1U - (ledConfigs[i].chainBit >> 3)] )
+#define LED_FRAME_MASK(i)       ( (u8_t)(1U << (ledConfigs[i].chainBit & 7U)) )
+
+/*!< Reads the frame latched in the chain, i is an index of ledConfigs */
+#define LED_IS_ON(i)            ( 0 != (LED_FRAME_BYTE(i) & LED_FRAME_MASK(i)) )
+
+/* MONITOR reads back and FAILSAFE clears the lamp pins of the DIO: with the 
+   chain they would supervise nothing, and FAILSAFE would clear LED_CHAIN_OE_PIN */
+#error "LED_BACKEND_SR595 is not supervised by MONITOR and FAILSAFE"
+
+#elif (LED_BACKEND == LED_BACKEND_DIO)
+
+/*!< Reads the PIN register cached by LED_StartLampCheck, i is an index of ledConfigs */
+#define LED_IS_ON(i)            ( 0 != (*LED_pinRegs[i] & LED_pinMasks[i]) )
+
+#else
+#error "LED_BACKEND must be LED_BACKEND_DIO or LED_BACKEND_SR595"
+#endif
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                           PRIVATE GLOBALS VARIABLES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< Set by LED_Lock, may be from an ISR */
+static volatile BOOL_t LED_isLocked = FALSE;
+
+#if (LED_BACKEND == LED_BACKEND_SR595)
+/*!< Outputs of the chain, as latched, in the order they are shifted */
+static u8_t LED_frame[LED_CHAIN_BYTES];
+
+/*!< PORT register and mask of the latch pin */
+static volatile u8_t * LED_pLatchPort = NULL;
+static u8_t LED_latchMask = 0;
+#else
+/*!< PIN register and mask of each LED, indexed as ledConfigs */
+static volatile u8_t * LED_pinRegs[NUM_OF_LEDS];
+static u8_t LED_pinMasks[NUM_OF_LEDS];
+#endif
+
+/*!< Lamp checked by the next tick, and the dark checks in a row of each lamp */
+static u8_t LED_checkIndex = 0;
+static u8_t LED_darkChecks[NUM_OF_LEDS];
+
+/*!< One LED_BIT per faulty lamp, written by the tick */
+static volatile u8_t LED_lampFaults = 0;
+
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
 /*                              PUBLIC FUNCTIONS                                */
@@ -32,17 +95,59 @@ static ERROR_t LED_ReadIndex(const LED_t led, s8_t * const ptr_s8Index);
 /*------------------------------------------------------------------------------*/
 
 ERROR_t LED_Init(void) {
+#if (LED_BACKEND == LED_BACKEND_SR595)
+    ERROR_t error = ERROR_OK;
+    volatile u8_t * pPinReg = NULL;
+    u8_t i = 0;
+
+    for(i = 0; i < countLedsConfigured; ++i) {
+        if( !ASSERT_LED(ledConfigs[i].led) || (ledConfigs[i].chainBit >= (LED_CHAIN_BYTES * 8U)) ) {
+            return ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    error |= DIO_GetPinRegisters(LED_CHAIN_LATCH_PIN, &LED_pLatchPort, &pPinReg, &LED_latchMask);
+    error |= SPI_Init();
+
+    if(ERROR_OK != error) {
+        return error;
+    }
+
+    GIE_Disable();
+
+    for(i = 0; i < LED_CHAIN_BYTES; ++i) {
+        LED_frame[i] = 0;
+    }
+
+    for(i = 0; i < countLedsConfigured; ++i) {
+        if(BIT_READ(LED_CHAIN_INIT_IMAGE, ledConfigs[i].led)) {
+            LED_FRAME_BYTE(i) |= LED_FRAME_MASK(i);
+        }
+    }
+
+    LED_ShiftFrame();
+
+    GIE_Enable();
+
+    /* The frame is latched, the outputs may be enabled */
+    return DIO_SetPinValue(LED_CHAIN_OE_PIN, LOW);
+#else
     return ERROR_OK;
+#endif
 }
 
 ERROR_t LED_SetClr(const LED_t led, const STATE_t state) { 
     ERROR_t error = ERROR_OK;
     s8_t i = 0;
     
+    if(LED_isLocked) {
+        return ERROR_BUSY;
+    }
+
     error |= LED_ReadIndex(led, &i);
     
     if(i >= 0) {
-        error |= DIO_SetPinValue(ledConfigs[i].pin, state);
+        error |= LED_WriteLamp((u8_t)i, state);
     } else {
         error |= ERROR_INVALID_PARAMETER;
     }
@@ -55,19 +160,118 @@ ERROR_t LED_Toggle(const LED_t led) {
     STATE_t state = LOW;
     s8_t i = 0;
     
+    if(LED_isLocked) {
+        return ERROR_BUSY;
+    }
+
     error |= LED_ReadIndex(led, &i);
     if(i < 0) {
         return ERROR_INVALID_PARAMETER;
     }
 
-    error |= DIO_ReadPin(ledConfigs[i].pin, &state);
+    error |= LED_ReadLamp((u8_t)i, &state);
 
     /* Toggle the LED */
-    DIO_SetPinValue(ledConfigs[i].pin, !state);
+    error |= LED_WriteLamp((u8_t)i, !state);
+
+    return error;
+}
+
+ERROR_t LED_SetImage(const u8_t image) {
+    ERROR_t error = ERROR_OK;
+    u8_t i = 0;
+
+    GIE_Disable();
+
+    if(LED_isLocked) {
+        error = ERROR_BUSY;
+    } else {
+        for(i = 0; i < countLedsConfigured; ++i) {
+            if( ASSERT_LED(ledConfigs[i].led) ) {
+#if (LED_BACKEND == LED_BACKEND_SR595)
+                if(BIT_READ(image, ledConfigs[i].led)) {
+                    LED_FRAME_BYTE(i) |= LED_FRAME_MASK(i);
+                } else {
+                    LED_FRAME_BYTE(i) &= (u8_t)~LED_FRAME_MASK(i);
+                }
+#else
+                error |= DIO_SetPinValue(ledConfigs[i].pin, BIT_READ(image, ledConfigs[i].led));
+#endif
+            } else {
+                error |= ERROR_INVALID_PARAMETER;
+            }
+        }
+
+#if (LED_BACKEND == LED_BACKEND_SR595)
+        /* All the lamps change at the same latch edge */
+        LED_ShiftFrame();
+#endif
+    }
+
+    GIE_Enable();
 
     return error;
 }
 
+void LED_Lock(void) {
+    LED_isLocked = TRUE;
+}
+
+ERROR_t LED_StartLampCheck(void) {
+    ERROR_t error = ERROR_OK;
+#if (LED_BACKEND == LED_BACKEND_DIO)
+    volatile u8_t * pPortReg = NULL;
+#endif
+    u8_t i = 0;
+
+    if(countLedsConfigured > NUM_OF_LEDS) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    for(i = 0; i < countLedsConfigured; ++i) {
+        if( !ASSERT_LED(ledConfigs[i].led) ) {
+            return ERROR_INVALID_PARAMETER;
+        }
+
+#if (LED_BACKEND == LED_BACKEND_DIO)
+        error |= DIO_GetPinRegisters(ledConfigs[i].pin, &pPortReg, &LED_pinRegs[i], &LED_pinMasks[i]);
+#endif
+        LED_darkChecks[i] = 0;
+    }
+
+    if(ERROR_OK == error) {
+        error |= TIMER_TickAddCallback(LED_CheckLamps);
+    }
+
+    return error;
+}
+
+ERROR_t LED_GetCurrent(const LED_t led, u16_t * const pMilliamps) {
+    ERROR_t error = ERROR_OK;
+    s8_t i = 0;
+
+    if(NULL == pMilliamps) {
+        return ERROR_NULL_POINTER;
+    }
+
+    error |= LED_ReadIndex(led, &i);
+    if(i >= 0) {
+        error |= LED_ReadMilliamps(ledConfigs[i].currentChannel, pMilliamps);
+    } else {
+        error |= ERROR_INVALID_PARAMETER;
+    }
+
+    return error;
+}
+
+BOOL_t LED_IsLampFault(const LED_t led) {
+    if( !ASSERT_LED(led) ) {
+        return FALSE;
+    }
+
+    return BIT_IS_SET(LED_lampFaults, led) ? TRUE : FALSE;
+}
+
 ERROR_t LED_Read(const LED_t led, STATE_t * const pState) { 
     ERROR_t error = ERROR_OK;
     s8_t i = 0;
@@ -78,7 +282,7 @@ ERROR_t LED_Read(const LED_t led, STATE_t * const pState) {
 
     error |= LED_ReadIndex(led, &i);
     if(i >= 0) {
-        error |= DIO_ReadPin(ledConfigs[i].pin, pState);
+        error |= LED_ReadLamp((u8_t)i, pState);
     } else {
         error |= ERROR_INVALID_PARAMETER;
     }
@@ -124,3 +328,115 @@ static ERROR_t LED_ReadIndex(const LED_t led, s8_t * const ptr_s8Index) {
     return ERROR_OK;
 }
 
+/******************************************************************************
+ * @brief Convert the averaged voltage of a sense resistor to a current
+ ******************************************************************************/
+static ERROR_t LED_ReadMilliamps(const ADC_CHANNEL_t channel, u16_t * const pMilliamps) {
+    ERROR_t error = ERROR_OK;
+    u16_t u16Millivolts = 0;
+
+    error |= ADC_ReadMillivolts(channel, &u16Millivolts);
+
+    *pMilliamps = (u16_t)( ((u32_t)u16Millivolts * 1000UL) / LED_SENSE_MILLIOHMS );
+
+    return error;
+}
+
+/******************************************************************************
+ * @brief   Check the next lamp for a missing current
+ * @details Tick callback, called every millisecond. A lamp is judged only while
+ *          it is the only lit lamp of its head: with another lamp lit, the 
+ *          current of the head says nothing about this one.
+ ******************************************************************************/
+static void LED_CheckLamps(void) {
+    const u8_t i = LED_checkIndex;
+    u16_t u16Milliamps = 0;
+    u8_t j = 0;
+
+    LED_checkIndex++;
+    if(LED_checkIndex >= countLedsConfigured) {
+        LED_checkIndex = 0;
+    }
+
+    /* Unchecked, off, or taken over by a safety function */
+    if( (0 == ledConfigs[i].nominalMa) || !LED_IS_ON(i) || LED_isLocked ) {
+        return;
+    }
+
+    for(j = 0; j < countLedsConfigured; ++j) {
+        if( (j != i) && (ledConfigs[j].currentChannel == ledConfigs[i].currentChannel) && LED_IS_ON(j) ) {
+            return;
+        }
+    }
+
+    if(ERROR_OK != LED_ReadMilliamps(ledConfigs[i].currentChannel, &u16Milliamps)) {
+        return;
+    }
+
+    if( ((u32_t)u16Milliamps * 100UL) < ((u32_t)ledConfigs[i].nominalMa * LED_FAULT_PERCENT) ) {
+        if(LED_darkChecks[i] < LED_FAULT_CHECKS) {
+            LED_darkChecks[i]++;
+
+            if(LED_FAULT_CHECKS == LED_darkChecks[i]) {
+                LED_lampFaults |= LED_BIT(ledConfigs[i].led);
+            }
+        }
+    } else {
+        LED_darkChecks[i] = 0;
+    }
+}
+
+/******************************************************************************
+ * @brief   Drive a lamp
+ * @param   i: index of the lamp in ledConfigs
+ * @param   state: HIGH to light it
+ ******************************************************************************/
+static ERROR_t LED_WriteLamp(const u8_t i, const STATE_t state) {
+#if (LED_BACKEND == LED_BACKEND_SR595)
+    GIE_Disable();
+
+    if(HIGH == state) {
+        LED_FRAME_BYTE(i) |= LED_FRAME_MASK(i);
+    } else {
+        LED_FRAME_BYTE(i) &= (u8_t)~LED_FRAME_MASK(i);
+    }
+
+    LED_ShiftFrame();
+
+    GIE_Enable();
+
+    return ERROR_OK;
+#else
+    return DIO_SetPinValue(ledConfigs[i].pin, state);
+#endif
+}
+
+/******************************************************************************
+ * @brief   Read the drive of a lamp
+ * @param   i: index of the lamp in ledConfigs
+ * @param   pState: HIGH if it is lit
+ ******************************************************************************/
+static ERROR_t LED_ReadLamp(const u8_t i, STATE_t * const pState) {
+#if (LED_BACKEND == LED_BACKEND_SR595)
+    *pState = LED_IS_ON(i) ? HIGH : LOW;
+
+    return ERROR_OK;
+#else
+    return DIO_ReadPin(ledConfigs[i].pin, pState);
+#endif
+}
+
+#if (LED_BACKEND == LED_BACKEND_SR595)
+/******************************************************************************
+ * @brief   Shift the frame into the chain and latch it
+ * @details Called with the interrupts disabled: a change of the frame during 
+ *          the shift would be latched half done
+ ******************************************************************************/
+static void LED_ShiftFrame(void) {
+    SPI_Transfer(LED_frame, NULL, LED_CHAIN_BYTES);
+
+    /* The rising edge copies the whole chain to the outputs at once */
+    *LED_pLatchPort |= LED_latchMask;
+    *LED_pLatchPort &= (u8_t)~LED_latchMask;
+}
+#endif
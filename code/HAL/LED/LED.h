@@ -27,6 +27,9 @@ typedef enum {
     NUM_OF_LEDS
 }LED_t;
 
+/*!< Bit of a LED in an image of all LEDs, see \ref LED_SetImage */
+#define LED_BIT(led)    ( (u8_t)(1U << (led)) )
+
 
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
@@ -89,6 +92,56 @@ ERROR_t LED_SetClr(const LED_t led, const STATE_t state);
  **********************************************************************************/
 ERROR_t LED_Toggle(const LED_t led);
 
+/**********************************************************************************
+ * @brief       Set all the LEDs at once
+ * @details     The interrupts are disabled while the LEDs are written, so an ISR
+ *              never sees a mix of the previous and the new image.
+ * @param[in]   image: one \ref LED_BIT per LED to turn on, the others are 
+ *              turned off
+ * @return      ERROR_t: error code, See options in \ref ERROR_t.
+ * @par         Example:
+ *  @code 
+ *      LED_SetImage(LED_BIT(LED_CAR_G) | LED_BIT(LED_PEDESTRIAN_R));
+ *  @endcode
+ **********************************************************************************/
+ERROR_t LED_SetImage(const u8_t image);
+
+/**********************************************************************************
+ * @brief       Refuse any later change of the LEDs
+ * @details     Used when the lamps are taken over by a safety function. The 
+ *              set, clear, toggle and image functions return ERROR_BUSY until 
+ *              the next reset.
+ **********************************************************************************/
+void LED_Lock(void);
+
+/**********************************************************************************
+ * @brief       Start checking the lit lamps for a missing current
+ * @details     Each tick checks the next lamp, so the ISR time is bounded 
+ *              whatever the number of lamps. A lamp that stays dark while 
+ *              commanded on is latched as faulty, see \ref LED_IsLampFault.
+ * @pre         ADC_Init and TIMER_TickInit
+ * @return      ERROR_t: error code, See options in \ref ERROR_t.
+ **********************************************************************************/
+ERROR_t LED_StartLampCheck(void);
+
+/**********************************************************************************
+ * @brief       Read the current of the signal head of a LED
+ * @details     The lamps of a head share their sense resistor: while the LED is 
+ *              the only lit lamp of its head, this is the current of the LED.
+ * @param[in]   led: See options in \ref LED_t.
+ * @param[out]  pMilliamps: the current in mA, averaged by the ADC
+ * @return      ERROR_t: error code, See options in \ref ERROR_t.
+ **********************************************************************************/
+ERROR_t LED_GetCurrent(const LED_t led, u16_t * const pMilliamps);
+
+/**********************************************************************************
+ * @brief       Tell if a lamp was found dark while commanded on
+ * @details     The fault is latched until the next reset.
+ * @param[in]   led: See options in \ref LED_t.
+ * @return      BOOL_t: TRUE if the lamp is faulty
+ **********************************************************************************/
+BOOL_t LED_IsLampFault(const LED_t led);
+
 /**********************************************************************************
  * @brief Reads the state of a specific LED.
  * @param[in] led: The LED to be read. See options in \ref LED_t.
@@ -8,6 +8,7 @@
  ******************************************************************************/
 #include "../../LIB/STD_TYPES.h"
 #include "../../MCAL/DIO/DIO.h"
+#include "../../MCAL/ADC/ADC.h"
 #include "LED.h"
 #include "LED_cfg.h"
 
@@ -18,13 +19,13 @@
 /*----------------------------------------------------------------------------*/
 
 LED_CONFIGS_t ledConfigs[] = {
-    {LED_CAR_R, DIO_PINS_CAR_LED_R},
-    {LED_CAR_Y, DIO_PINS_CAR_LED_Y},
-    {LED_CAR_G, DIO_PINS_CAR_LED_G},
+    {LED_CAR_R,        DIO_PINS_CAR_LED_R,        0, ADC_CHANNEL_6, 300},
+    {LED_CAR_Y,        DIO_PINS_CAR_LED_Y,        1, ADC_CHANNEL_6, 300},
+    {LED_CAR_G,        DIO_PINS_CAR_LED_G,        2, ADC_CHANNEL_6, 300},
 
-    {LED_PEDESTRIAN_R, DIO_PINS_PEDESTRIAN_LED_R},
-    {LED_PEDESTRIAN_Y, DIO_PINS_PEDESTRIAN_LED_Y},
-    {LED_PEDESTRIAN_G, DIO_PINS_PEDESTRIAN_LED_G},
+    {LED_PEDESTRIAN_R, DIO_PINS_PEDESTRIAN_LED_R, 3, ADC_CHANNEL_7, 150},
+    {LED_PEDESTRIAN_Y, DIO_PINS_PEDESTRIAN_LED_Y, 4, ADC_CHANNEL_7, 150},
+    {LED_PEDESTRIAN_G, DIO_PINS_PEDESTRIAN_LED_G, 5, ADC_CHANNEL_7, 150},
 };
 
 /*----------------------------------------------------------------------------*/
@@ -9,15 +9,80 @@
 #ifndef LED_CFG_H   
 #define LED_CFG_H   
 
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              DO NOT CHANGE ANYTHING BELOW THIS COMMENT                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#define LED_BACKEND_DIO         0
+#define LED_BACKEND_SR595       1
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Drive of the lamps
+ *          Options are:
+ *              LED_BACKEND_DIO   --> one DIO pin per lamp, the pin of ledConfigs
+ *              LED_BACKEND_SR595 --> a chain of 74HC595 on the SPI, the 
+ *                                    chainBit of ledConfigs. The whole frame is
+ *                                    shifted on each change, then latched at 
+ *                                    once: ~5 us for 4 registers at F_CPU / 2
+ * @note    LED_BACKEND_SR595 is rejected by LED.c: MONITOR and FAILSAFE read 
+ *          back and clear the lamp pins of the DIO, they would supervise 
+ *          nothing
+ ******************************************************************************/
+#define LED_BACKEND             LED_BACKEND_DIO
+
+/*!< 74HC595 in the chain. Bit 8 * k + n of chainBit is the output Qn of the 
+     k-th register from the MCU */
+#define LED_CHAIN_BYTES         (4U)
+
+/*!< RCLK of all the registers, its rising edge latches the frame. SRCLK is 
+     SCK, SER of the first register is MOSI, /SRCLR is tied high */
+#define LED_CHAIN_LATCH_PIN     DIO_PINS_LAMPS_LATCH
+
+/*!< /OE of all the registers, pulled up on the board. PA0 is not a lamp with
+     this backend and DIO_EarlyInit drives it high, so the outputs stay off 
+     until LED_Init drives it low after the first latch */
+#define LED_CHAIN_OE_PIN        DIO_PINS_CAR_LED_R
+
+/*!< Latched by LED_Init before the outputs are enabled: the registers power up
+     with unknown contents */
+#define LED_CHAIN_INIT_IMAGE    ( LED_BIT(LED_CAR_R) | LED_BIT(LED_PEDESTRIAN_R) )
+
+/*!< Current sense resistor of a signal head in milliohms */
+#define LED_SENSE_MILLIOHMS     (1000UL)
+
+/*!< A lit lamp drawing less than this percentage of its nominal current is dark */
+#define LED_FAULT_PERCENT       (50UL)
+
+/*!< Consecutive dark checks before the lamp fault is latched. The lamps are 
+     checked in turn, one per tick, so this is ~LED_FAULT_CHECKS * NUM_OF_LEDS ms */
+#define LED_FAULT_CHECKS        (20U)
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
 
+/******************************************************************************
+ * @brief   The lamp is driven by its pin or its chainBit, see LED_BACKEND.
+ *          The lamps of a signal head share the sense resistor on currentChannel.
+ *          A lamp is checked only while it is the only lit lamp of its head,
+ *          a nominalMa of 0 leaves it unchecked.
+ ******************************************************************************/
 typedef struct{
-    LED_t       led;
-    DIO_PINS_t  pin;
+    LED_t           led;
+    DIO_PINS_t      pin;
+    u8_t            chainBit;
+    ADC_CHANNEL_t   currentChannel;
+    u16_t           nominalMa;
 }LED_CONFIGS_t;
 
 extern LED_CONFIGS_t ledConfigs[];
@@ -0,0 +1,218 @@
+/**********************************************************************************
+ * @file        MONITOR.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Conflict monitor of the lamp outputs
+ * @details     Every tick the lamp pins are read back in one access of PINx, 
+ *              and checked with one lookup in a bitmap of the 256 port images:
+ *              bit (image) of the table is set if the image has no conflict.
+ *              The check takes the same time whatever the lamps are.
+ * @version     1.0.0
+ * @date        2026-10-19
+ **********************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+#include "../../MCAL/DIO/DIO.h"
+#include "../../MCAL/TIMER/TIMER.h"
+#include "../LED/LED.h"
+#include "../FAILSAFE/FAILSAFE.h"
+#include "MONITOR.h"
+#include "MONITOR_cfg.h"
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            PRIVATE FUNCTIONS PROTOTYPES                      */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+static ERROR_t MONITOR_GetMask(const DIO_PINS_t * const pPins, const u8_t count, u8_t * const pMask);
+static void MONITOR_Check(void);
+static void MONITOR_Flash(void);
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            MACRO LIKE FUNCTIONS                              */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+#define MONITOR_IS_ALLOWED(image)   ( MONITOR_allowed[(image) >> 3] & (u8_t)(1U << ((image) & 7U)) )
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                           PRIVATE GLOBALS VARIABLES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< One bit per image of the lamp port: set if the image has no conflict */
+static u8_t MONITOR_allowed[256U / 8U];
+
+/*!< Registers of the lamp port, and the bits of the lamps in it */
+static volatile u8_t * MONITOR_pPort = NULL;
+static volatile u8_t * MONITOR_pPin = NULL;
+static u8_t MONITOR_lampMask = 0;
+static u8_t MONITOR_redMask = 0;
+
+static u8_t MONITOR_mismatchTicks = 0;
+
+/*!< Fault state, latched until the next reset */
+static volatile BOOL_t MONITOR_isFault = FALSE;
+static u8_t MONITOR_faultImage = 0;
+static u16_t MONITOR_flashMs = 0;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PUBLIC FUNCTIONS                                */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+ERROR_t MONITOR_Init(void) {
+    ERROR_t error = ERROR_OK;
+    u8_t au8Conflicts[2] = {0};
+    u8_t u8Conflict = 0;
+    u16_t u16Image = 0;
+    u8_t i = 0;
+
+    error |= MONITOR_GetMask(monitorLamps, countMonitorLamps, &MONITOR_lampMask);
+    error |= MONITOR_GetMask(monitorRedLamps, countMonitorRedLamps, &MONITOR_redMask);
+
+    if(ERROR_OK != error) {
+        return error;
+    }
+
+    /* All images allowed, then remove the ones holding a conflict */
+    for(i = 0; i < sizeof(MONITOR_allowed); ++i) {
+        MONITOR_allowed[i] = 0xFF;
+    }
+
+    for(i = 0; i < countMonitorConflicts; ++i) {
+        error |= MONITOR_GetMask(&monitorConflicts[i].first, 1, &au8Conflicts[0]);
+        error |= MONITOR_GetMask(&monitorConflicts[i].second, 1, &au8Conflicts[1]);
+        u8Conflict = au8Conflicts[0] | au8Conflicts[1];
+
+        for(u16Image = 0; u16Image < 256U; ++u16Image) {
+            if(u8Conflict == (u16Image & u8Conflict)) {
+                BIT_CLR(MONITOR_allowed[u16Image >> 3], u16Image & 7U);
+            }
+        }
+    }
+
+    if(ERROR_OK != error) {
+        return error;
+    }
+
+    MONITOR_mismatchTicks = 0;
+    MONITOR_isFault = FALSE;
+
+    error |= TIMER_TickAddCallback(MONITOR_Check);
+
+    return error;
+}
+
+BOOL_t MONITOR_IsFault(void) {
+    return MONITOR_isFault;
+}
+
+ERROR_t MONITOR_GetFaultImage(u8_t * const pImage) {
+    if(NULL == pImage) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(!MONITOR_isFault) {
+        return ERROR_NOK;
+    }
+
+    *pImage = MONITOR_faultImage;
+
+    return ERROR_OK;
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PRIVATE FUNCTIONS                               */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Get the bits of pins in the lamp port
+ * @details The first pin seen sets the lamp port, all the pins must be on it
+ ******************************************************************************/
+static ERROR_t MONITOR_GetMask(const DIO_PINS_t * const pPins, const u8_t count, u8_t * const pMask) {
+    volatile u8_t * pPort = NULL;
+    volatile u8_t * pPin = NULL;
+    u8_t u8Bit = 0;
+    u8_t i = 0;
+
+    *pMask = 0;
+
+    for(i = 0; i < count; ++i) {
+        if(ERROR_OK != DIO_GetPinRegisters(pPins[i], &pPort, &pPin, &u8Bit)) {
+            return ERROR_INVALID_PARAMETER;
+        }
+
+        if(NULL == MONITOR_pPort) {
+            MONITOR_pPort = pPort;
+            MONITOR_pPin = pPin;
+        } else if(pPort != MONITOR_pPort) {
+            return ERROR_INVALID_PARAMETER;
+        } else {
+            /* Same port */
+        }
+
+        *pMask |= u8Bit;
+    }
+
+    return ERROR_OK;
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              ISR CALLBACKS                                   */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Check the lamps, every tick
+ ******************************************************************************/
+static void MONITOR_Check(void) {
+    u8_t u8Pins = 0;
+    u8_t u8Image = 0;
+
+    if(MONITOR_isFault) {
+        MONITOR_Flash();
+        return;
+    }
+
+    u8Pins = *MONITOR_pPin;
+    u8Image = u8Pins & MONITOR_lampMask;
+
+    /* A lamp pin that does not follow its output may hide a conflict */
+    if( (*MONITOR_pPort ^ u8Pins) & MONITOR_lampMask ) {
+        MONITOR_mismatchTicks++;
+    } else {
+        MONITOR_mismatchTicks = 0;
+    }
+
+    if( !MONITOR_IS_ALLOWED(u8Image) || (MONITOR_mismatchTicks >= MONITOR_MISMATCH_TICKS) ) {
+        MONITOR_isFault = TRUE;
+        MONITOR_faultImage = u8Image;
+        MONITOR_flashMs = 0;
+
+        LED_Lock();
+
+        /* Never returns once the failsafe is initialized, the software flash
+           is the fallback */
+        FAILSAFE_Enter();
+        MONITOR_Flash();
+    }
+}
+
+/******************************************************************************
+ * @brief   All red flash: the lamp port is rewritten every tick
+ ******************************************************************************/
+static void MONITOR_Flash(void) {
+    u8_t u8Lamps = (MONITOR_flashMs < MONITOR_FLASH_MS) ? MONITOR_redMask : 0;
+
+    *MONITOR_pPort = (*MONITOR_pPort & (u8_t)~MONITOR_lampMask) | u8Lamps;
+
+    MONITOR_flashMs++;
+    if(MONITOR_flashMs >= (2U * MONITOR_FLASH_MS)) {
+        MONITOR_flashMs = 0;
+    }
+}
@@ -0,0 +1,46 @@
+/******************************************************************************
+ * @file        MONITOR.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref MONITOR.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef MONITOR_H
+#define MONITOR_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the conflict monitor
+ * @details     Builds the table of the allowed lamp images from the conflicts
+ *              in MONITOR_cfg.c, then checks the lamp pins on every tick.
+ *              On a conflicting image, or lamp pins that do not follow their 
+ *              outputs, the LEDs are locked and the failsafe takes over, see 
+ *              \ref FAILSAFE_Enter. Without the failsafe, the red lamps flash 
+ *              from the tick ISR until the next reset.
+ * @pre         \ref DIO_Init, \ref TIMER_TickInit
+ * @return      ERROR_t: ERROR_INVALID_PARAMETER if the lamps are not all on 
+ *              the same port. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t MONITOR_Init(void);
+
+/******************************************************************************
+ * @brief       Check if the monitor has taken over the lamps
+ * @return      BOOL_t: TRUE after a fault, until the next reset
+ *****************************************************************************/
+BOOL_t MONITOR_IsFault(void);
+
+/******************************************************************************
+ * @brief       Get the lamp pins read when the fault was detected
+ * @param[out]  pImage: the PINx register masked by the monitored lamps
+ * @return      ERROR_t: ERROR_NOK if there was no fault. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t MONITOR_GetFaultImage(u8_t * const pImage);
+
+
+#endif      /* MONITOR_H */
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * @file        MONITOR_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref MONITOR.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../MCAL/DIO/DIO.h"
+#include "MONITOR.h"
+#include "MONITOR_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*****************************************************************************
+ * @note    All monitored lamps must be on the same port, so one read of PINx
+ *          gives the whole image.
+ *****************************************************************************/
+const DIO_PINS_t monitorLamps[] = {
+    DIO_PINS_CAR_LED_R,
+    DIO_PINS_CAR_LED_Y,
+    DIO_PINS_CAR_LED_G,
+    DIO_PINS_PEDESTRIAN_LED_R,
+    DIO_PINS_PEDESTRIAN_LED_Y,
+    DIO_PINS_PEDESTRIAN_LED_G,
+};
+
+/*!< Flashed after a fault, all the other lamps are off */
+const DIO_PINS_t monitorRedLamps[] = {
+    DIO_PINS_CAR_LED_R,
+    DIO_PINS_PEDESTRIAN_LED_R,
+};
+
+/*****************************************************************************
+ * @note    Cars' yellow with pedestrian's green is allowed: it is the 
+ *          pedestrian's final state.
+ *****************************************************************************/
+const MONITOR_CONFLICTS_t monitorConflicts[] = {
+    {DIO_PINS_CAR_LED_G,        DIO_PINS_PEDESTRIAN_LED_G},
+    {DIO_PINS_CAR_LED_G,        DIO_PINS_CAR_LED_R},
+    {DIO_PINS_PEDESTRIAN_LED_G, DIO_PINS_PEDESTRIAN_LED_R},
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     DO NOT CHANGE ANYTHING BELOW THIS LINE                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const u8_t countMonitorLamps = sizeof(monitorLamps) / sizeof(monitorLamps[0]);
+const u8_t countMonitorRedLamps = sizeof(monitorRedLamps) / sizeof(monitorRedLamps[0]);
+const u8_t countMonitorConflicts = sizeof(monitorConflicts) / sizeof(monitorConflicts[0]);
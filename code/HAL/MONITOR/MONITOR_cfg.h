@@ -0,0 +1,49 @@
+/******************************************************************************
+ * @file        MONITOR_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref MONITOR.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef MONITOR_CFG_H
+#define MONITOR_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< On and off time of the red lamps after a fault */
+#define MONITOR_FLASH_MS        (500U)
+
+/*!< Consecutive ticks a lamp pin may differ from its output before it is a 
+     fault (shorted or open lamp driver) */
+#define MONITOR_MISMATCH_TICKS  (3U)
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @note    Members:
+ *          - first, second: Two lamps that must never be on together
+ *****************************************************************************/
+typedef struct {
+    DIO_PINS_t      first;
+    DIO_PINS_t      second;
+}MONITOR_CONFLICTS_t;
+
+extern const DIO_PINS_t monitorLamps[];
+extern const u8_t countMonitorLamps;
+
+extern const DIO_PINS_t monitorRedLamps[];
+extern const u8_t countMonitorRedLamps;
+
+extern const MONITOR_CONFLICTS_t monitorConflicts[];
+extern const u8_t countMonitorConflicts;
+
+#endif      /* MONITOR_CFG_H */
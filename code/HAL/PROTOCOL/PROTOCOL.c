@@ -0,0 +1,315 @@
+/**************************************************************************
+ * @file        PROTOCOL.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Framing of the command link, over the UART
+ * @details     The receiver is a state machine fed one byte at a time: it 
+ *              keeps the payload of the frame being received and nothing 
+ *              else. It resynchronizes on the next PROTOCOL_SOF after a bad 
+ *              length, a bad CRC or a silent line.
+ *              The sender has no frame buffer: the header, each part of the 
+ *              payload and the CRC are queued in the UART transmit ring as 
+ *              they come, the CRC is computed on the way.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ***************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+
+#include "../../MCAL/UART/UART.h"
+#include "../../MCAL/TIMER/TIMER.h"
+
+#include "PROTOCOL.h"
+#include "PROTOCOL_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                            MACRO LIKE FUNCTIONS                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Start of frame, length, type and CRC */
+#define PROTOCOL_OVERHEAD           (5U)
+#define PROTOCOL_MAX_TX_FRAME       ( PROTOCOL_MAX_TX_PAYLOAD + PROTOCOL_OVERHEAD )
+
+#if (PROTOCOL_MAX_RX_PAYLOAD > 255U) || (PROTOCOL_MAX_TX_PAYLOAD > 250U)
+#error "The length of a frame is a single byte"
+#endif
+
+/*!< CRC-16/CCITT */
+#define PROTOCOL_CRC_POLYNOMIAL     (0x1021U)
+#define PROTOCOL_CRC_INITIAL        (0xFFFFU)
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   The next byte expected by the parser
+ *****************************************************************************/
+typedef enum {
+    PROTOCOL_WAIT_SOF,
+    PROTOCOL_WAIT_LENGTH,
+    PROTOCOL_WAIT_TYPE,
+    PROTOCOL_WAIT_PAYLOAD,
+    PROTOCOL_WAIT_CRC_LOW,
+    PROTOCOL_WAIT_CRC_HIGH,
+    PROTOCOL_FRAME_READY,       /*!< A valid frame waits for the handler */
+}PROTOCOL_RX_STATE_t;
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                      PRIVATE FUNCTIONS PROTOTYPES                          */
+/*                                                                            */                              
+/*----------------------------------------------------------------------------*/
+static void PROTOCOL_ParseByte(const u8_t byte);
+static u16_t PROTOCOL_UpdateCrc(u16_t crc, const u8_t byte);
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                           PRIVATE GLOBALS VARIABLES                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+static PROTOCOL_HANDLER_t PROTOCOL_handler = NULL;
+
+/*!< Frame being received */
+static PROTOCOL_RX_STATE_t PROTOCOL_rxState = PROTOCOL_WAIT_SOF;
+static u8_t PROTOCOL_rxLength = 0;
+static u8_t PROTOCOL_rxType = 0;
+static u8_t PROTOCOL_rxCount = 0;
+static u16_t PROTOCOL_rxCrc = 0;
+static u8_t PROTOCOL_rxPayload[PROTOCOL_MAX_RX_PAYLOAD];
+static u32_t PROTOCOL_rxLastByteMs = 0;
+
+/*!< Frame being sent: declared and added lengths of its payload */
+static BOOL_t isTxOpen = FALSE;
+static u8_t PROTOCOL_txLength = 0;
+static u8_t PROTOCOL_txCount = 0;
+static u16_t PROTOCOL_txCrc = 0;
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PUBLIC FUNCTIONS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+ERROR_t PROTOCOL_Init(const PROTOCOL_HANDLER_t handler) {
+    if(NULL == handler) {
+        return ERROR_NULL_POINTER;
+    }
+
+    /* The ring is empty, a reply frame must fit in it */
+    if(UART_GetTxSpace() < PROTOCOL_MAX_TX_FRAME) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    PROTOCOL_rxState = PROTOCOL_WAIT_SOF;
+    isTxOpen = FALSE;
+    PROTOCOL_handler = handler;
+
+    return ERROR_OK;
+}
+
+void PROTOCOL_Update(void) {
+    u32_t u32NowMs = TIMER_GetTickMs();
+    u8_t u8Byte = 0;
+
+    if(NULL == PROTOCOL_handler) {
+        return;
+    }
+
+    if( (PROTOCOL_WAIT_SOF != PROTOCOL_rxState) && (PROTOCOL_FRAME_READY != PROTOCOL_rxState) &&
+        ((u32NowMs - PROTOCOL_rxLastByteMs) >= PROTOCOL_BYTE_TIMEOUT_MS) ) {
+        PROTOCOL_rxState = PROTOCOL_WAIT_SOF;
+    }
+
+    /* A ready frame holds the next bytes in the UART ring */
+    while( (PROTOCOL_FRAME_READY != PROTOCOL_rxState) && (ERROR_OK == UART_Receive(&u8Byte)) ) {
+        PROTOCOL_rxLastByteMs = u32NowMs;
+        PROTOCOL_ParseByte(u8Byte);
+    }
+
+    if( (PROTOCOL_FRAME_READY == PROTOCOL_rxState) && !isTxOpen && 
+        (UART_GetTxSpace() >= PROTOCOL_MAX_TX_FRAME) ) {
+        PROTOCOL_handler(PROTOCOL_rxType, PROTOCOL_rxPayload, PROTOCOL_rxLength);
+        PROTOCOL_rxState = PROTOCOL_WAIT_SOF;
+    }
+}
+
+ERROR_t PROTOCOL_BeginFrame(const u8_t type, const u8_t length) {
+    u8_t au8Header[3] = {PROTOCOL_SOF, 0, 0};
+
+    if(isTxOpen) {
+        return ERROR_BUSY;
+    }
+
+    if(length > PROTOCOL_MAX_TX_PAYLOAD) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    /* The room is reserved: only the ISR takes bytes until the frame ends */
+    if(UART_GetTxSpace() < (u8_t)(length + PROTOCOL_OVERHEAD)) {
+        return ERROR_BUSY;
+    }
+
+    au8Header[1] = length;
+    au8Header[2] = type;
+    UART_Send(au8Header, sizeof(au8Header));
+
+    PROTOCOL_txCrc = PROTOCOL_UpdateCrc(PROTOCOL_CRC_INITIAL, length);
+    PROTOCOL_txCrc = PROTOCOL_UpdateCrc(PROTOCOL_txCrc, type);
+    PROTOCOL_txLength = length;
+    PROTOCOL_txCount = 0;
+    isTxOpen = TRUE;
+
+    return ERROR_OK;
+}
+
+ERROR_t PROTOCOL_AddPayload(const void * const pData, const u8_t length) {
+    const u8_t * pu8Data = (const u8_t *)pData;
+    u8_t i = 0;
+
+    if(NULL == pData) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(!isTxOpen) {
+        return ERROR_NOK;
+    }
+
+    if(length > (u8_t)(PROTOCOL_txLength - PROTOCOL_txCount)) {
+        return ERROR_OUT_OF_RANGE;
+    }
+
+    UART_Send(pu8Data, length);
+
+    for(i = 0; i < length; ++i) {
+        PROTOCOL_txCrc = PROTOCOL_UpdateCrc(PROTOCOL_txCrc, pu8Data[i]);
+    }
+
+    PROTOCOL_txCount += length;
+
+    return ERROR_OK;
+}
+
+ERROR_t PROTOCOL_EndFrame(void) {
+    ERROR_t error = ERROR_OK;
+    u8_t au8Crc[2] = {0, 0};
+
+    if(!isTxOpen) {
+        return ERROR_NOK;
+    }
+
+    /* Keep the framing of the line, the receiver checks the length */
+    while(PROTOCOL_txCount < PROTOCOL_txLength) {
+        error = ERROR_NOK;
+        PROTOCOL_AddPayload(&au8Crc[0], 1);
+    }
+
+    au8Crc[0] = (u8_t)PROTOCOL_txCrc;
+    au8Crc[1] = (u8_t)(PROTOCOL_txCrc >> 8);
+    UART_Send(au8Crc, sizeof(au8Crc));
+
+    isTxOpen = FALSE;
+
+    return error;
+}
+
+ERROR_t PROTOCOL_SendFrame(const u8_t type, const void * const pPayload, const u8_t length) {
+    ERROR_t error = ERROR_OK;
+
+    if( (NULL == pPayload) && (0 != length) ) {
+        return ERROR_NULL_POINTER;
+    }
+
+    error = PROTOCOL_BeginFrame(type, length);
+    if(ERROR_OK != error) {
+        return error;
+    }
+
+    if(0 != length) {
+        error |= PROTOCOL_AddPayload(pPayload, length);
+    }
+
+    error |= PROTOCOL_EndFrame();
+
+    return error;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PRIVATE FUNCTIONS                                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief Feed a received byte to the parser
+ * 
+ * @param[in] byte: the byte
+ * @return void
+ ******************************************************************************/
+static void PROTOCOL_ParseByte(const u8_t byte) {
+    switch(PROTOCOL_rxState) {
+        case PROTOCOL_WAIT_SOF:
+            if(PROTOCOL_SOF == byte) {
+                PROTOCOL_rxState = PROTOCOL_WAIT_LENGTH;
+            }
+            break;
+        case PROTOCOL_WAIT_LENGTH:
+            if(byte > PROTOCOL_MAX_RX_PAYLOAD) {
+                PROTOCOL_rxState = PROTOCOL_WAIT_SOF;
+            } else {
+                PROTOCOL_rxLength = byte;
+                PROTOCOL_rxCount = 0;
+                PROTOCOL_rxCrc = PROTOCOL_UpdateCrc(PROTOCOL_CRC_INITIAL, byte);
+                PROTOCOL_rxState = PROTOCOL_WAIT_TYPE;
+            }
+            break;
+        case PROTOCOL_WAIT_TYPE:
+            PROTOCOL_rxType = byte;
+            PROTOCOL_rxCrc = PROTOCOL_UpdateCrc(PROTOCOL_rxCrc, byte);
+            PROTOCOL_rxState = (0 == PROTOCOL_rxLength) ? PROTOCOL_WAIT_CRC_LOW : PROTOCOL_WAIT_PAYLOAD;
+            break;
+        case PROTOCOL_WAIT_PAYLOAD:
+            PROTOCOL_rxPayload[PROTOCOL_rxCount++] = byte;
+            PROTOCOL_rxCrc = PROTOCOL_UpdateCrc(PROTOCOL_rxCrc, byte);
+            if(PROTOCOL_rxCount >= PROTOCOL_rxLength) {
+                PROTOCOL_rxState = PROTOCOL_WAIT_CRC_LOW;
+            }
+            break;
+        case PROTOCOL_WAIT_CRC_LOW:
+            PROTOCOL_rxState = (byte == (u8_t)PROTOCOL_rxCrc) ? PROTOCOL_WAIT_CRC_HIGH : PROTOCOL_WAIT_SOF;
+            break;
+        case PROTOCOL_WAIT_CRC_HIGH:
+            PROTOCOL_rxState = (byte == (u8_t)(PROTOCOL_rxCrc >> 8)) ? PROTOCOL_FRAME_READY : PROTOCOL_WAIT_SOF;
+            break;
+        default:
+            PROTOCOL_rxState = PROTOCOL_WAIT_SOF;
+            break;
+    }
+}
+
+/******************************************************************************
+ * @brief Add a byte to a CRC-16/CCITT, bitwise: no table in flash
+ * 
+ * @param[in] crc: the CRC of the previous bytes
+ * @param[in] byte: the byte
+ * @return u16_t: the CRC including the byte
+ ******************************************************************************/
+static u16_t PROTOCOL_UpdateCrc(u16_t crc, const u8_t byte) {
+    u8_t i = 0;
+
+    crc ^= (u16_t)byte << 8;
+
+    for(i = 0; i < 8U; ++i) {
+        if(crc & 0x8000U) {
+            crc = (u16_t)(crc << 1) ^ PROTOCOL_CRC_POLYNOMIAL;
+        } else {
+            crc = (u16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
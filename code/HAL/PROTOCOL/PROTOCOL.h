@@ -0,0 +1,94 @@
+/******************************************************************************
+ * @file        PROTOCOL.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref PROTOCOL.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Handler of the received frames
+ * @param   type: the type byte of the frame
+ * @param   pPayload: its payload, valid until the handler returns
+ * @param   length: the length of the payload
+ *****************************************************************************/
+typedef void (*PROTOCOL_HANDLER_t)(const u8_t type, const u8_t * const pPayload, const u8_t length);
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the framing over the UART
+ * @details     A frame is:
+ *              | PROTOCOL_SOF | length | type | payload | CRC low | CRC high |
+ *              length counts the payload only. The CRC is the CRC-16/CCITT 
+ *              (polynomial 0x1021, initial value 0xFFFF) of the length, the 
+ *              type and the payload. Multi-byte values are little endian.
+ * @pre         UART_Init
+ * @param[in]   handler: called by \ref PROTOCOL_Update for each valid frame
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t PROTOCOL_Init(const PROTOCOL_HANDLER_t handler);
+
+/******************************************************************************
+ * @brief       Parse the received bytes
+ * @details     Never blocks, to be polled. The bytes are parsed one at a time,
+ *              only the payload is kept. A frame with a wrong CRC is dropped 
+ *              without notice. The handler of a valid frame is called from 
+ *              here, once the UART has room for the longest reply.
+ * @return      void
+ *****************************************************************************/
+void PROTOCOL_Update(void);
+
+/******************************************************************************
+ * @brief       Start sending a frame
+ * @details     The payload is then added by \ref PROTOCOL_AddPayload, straight
+ *              from where it lives: it goes through the CRC into the UART 
+ *              transmit ring, with no frame buffer. 
+ * @param[in]   type: the type byte of the frame
+ * @param[in]   length: the length of the whole payload, up to 
+ *              PROTOCOL_MAX_TX_PAYLOAD
+ * @return      ERROR_t: ERROR_BUSY if the UART has no room for the frame. See
+ *              \ref ERROR_t
+ *****************************************************************************/
+ERROR_t PROTOCOL_BeginFrame(const u8_t type, const u8_t length);
+
+/******************************************************************************
+ * @brief       Add a part of the payload of the frame started
+ * @param[in]   pData: the bytes, sent in memory order
+ * @param[in]   length: their number
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t PROTOCOL_AddPayload(const void * const pData, const u8_t length);
+
+/******************************************************************************
+ * @brief       End the frame started, by its CRC
+ * @details     A payload shorter than declared is padded with zeros.
+ * @return      ERROR_t: ERROR_NOK if the payload was padded. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t PROTOCOL_EndFrame(void);
+
+/******************************************************************************
+ * @brief       Send a frame of one part
+ * @param[in]   type: the type byte of the frame
+ * @param[in]   pPayload: the payload, can be NULL if length is 0
+ * @param[in]   length: the length of the payload
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t PROTOCOL_SendFrame(const u8_t type, const void * const pPayload, const u8_t length);
+
+
+#endif      /* PROTOCOL_H */
@@ -0,0 +1,44 @@
+/******************************************************************************
+ * @file        PROTOCOL_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref PROTOCOL.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef PROTOCOL_CFG_H
+#define PROTOCOL_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    CHANGE THE FOLLOWING TO YOUR NEEDS                      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   First byte of every frame
+ ******************************************************************************/
+#define PROTOCOL_SOF                (0xA5U)
+
+/******************************************************************************
+ * @brief   Longest payload of a received frame: the only buffer of the 
+ *          parser. Longer frames are dropped
+ ******************************************************************************/
+#define PROTOCOL_MAX_RX_PAYLOAD     (16U)
+
+/******************************************************************************
+ * @brief   Longest payload of a sent frame. A received frame is handled once
+ *          the UART transmit ring has room for a frame this long, so the 
+ *          reply is never dropped
+ * @warning The frame, PROTOCOL_MAX_TX_PAYLOAD + 5 bytes, must fit in the UART
+ *          transmit ring
+ ******************************************************************************/
+#define PROTOCOL_MAX_TX_PAYLOAD     (56U)
+
+/******************************************************************************
+ * @brief   A frame is dropped when its next byte does not come within this 
+ *          time, the parser waits for a new PROTOCOL_SOF
+ ******************************************************************************/
+#define PROTOCOL_BYTE_TIMEOUT_MS    (20UL)
+
+#endif      /* PROTOCOL_CFG_H */
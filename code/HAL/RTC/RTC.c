@@ -0,0 +1,247 @@
+/**************************************************************************
+ * @file        RTC.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Time of day clock and timing plans schedule
+ * @details     The clock is a second of the day, counted by a tick callback.
+ *              Once per second, the callback compares it with the start of the
+ *              next schedule entry only, and switches the plan when it is 
+ *              reached. The application reads the plan when it can apply it,
+ *              it never reads the clock for that.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ***************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+
+#include "../../MCAL/GIE/GIE.h"
+#include "../../MCAL/TIMER/TIMER.h"
+
+#include "RTC.h"
+#include "RTC_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                      PRIVATE FUNCTIONS PROTOTYPES                          */
+/*                                                                            */                              
+/*----------------------------------------------------------------------------*/
+static void RTC_Tick(void);
+static void RTC_FindPlan(const u32_t u32SecondOfDay);
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                            MACRO LIKE FUNCTIONS                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define ASSERT_PLAN(plan)       ( plan < NUM_OF_RTC_PLANS )
+#define ASSERT_TIME(time)       ( ((time).hours < 24U) && ((time).minutes < 60U) && ((time).seconds < 60U) )
+
+#define RTC_SECONDS_PER_DAY     (86400UL)
+#define RTC_MS_PER_SECOND       (1000U)
+
+#define RTC_TO_SECONDS(time)    ( ((u32_t)(time).hours * 3600UL) + ((u32_t)(time).minutes * 60UL) + (u32_t)(time).seconds )
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                           PRIVATE GLOBALS VARIABLES                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Time of day, counted by the tick */
+static volatile u32_t RTC_secondOfDay = 0;
+static u16_t RTC_msOfSecond = 0;
+
+static volatile BOOL_t RTC_isTimeSet = FALSE;
+
+/*!< The entry that starts next, and its second of the day */
+static u8_t RTC_nextEntry = 0;
+static u32_t RTC_nextEntrySecond = 0;
+
+static volatile RTC_PLAN_t RTC_plan = RTC_UNSET_PLAN;
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PUBLIC FUNCTIONS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+ERROR_t RTC_Init(void) {
+    u8_t i = 0;
+
+    if( !ASSERT_PLAN(RTC_UNSET_PLAN) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    for(i = 0; i < countRtcSchedule; ++i) {
+        if( !ASSERT_TIME(rtcSchedule[i].start) || !ASSERT_PLAN(rtcSchedule[i].plan) ) {
+            return ERROR_INVALID_PARAMETER;
+        }
+
+        /* Sorted, the tick only looks at the next entry */
+        if( (i > 0) && (RTC_TO_SECONDS(rtcSchedule[i].start) <= RTC_TO_SECONDS(rtcSchedule[i - 1].start)) ) {
+            return ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    GIE_Disable();
+
+    RTC_secondOfDay = 0;
+    RTC_msOfSecond = 0;
+    RTC_isTimeSet = FALSE;
+    RTC_plan = RTC_UNSET_PLAN;
+
+    GIE_Enable();
+
+    return TIMER_TickAddCallback(RTC_Tick);
+}
+
+ERROR_t RTC_SetTime(const RTC_TIME_t * const pTime) {
+    u32_t u32SecondOfDay = 0;
+
+    if(NULL == pTime) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if( !ASSERT_TIME(*pTime) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    u32SecondOfDay = RTC_TO_SECONDS(*pTime);
+
+    GIE_Disable();
+
+    RTC_secondOfDay = u32SecondOfDay;
+    RTC_msOfSecond = 0;
+    RTC_isTimeSet = TRUE;
+
+    RTC_FindPlan(u32SecondOfDay);
+
+    GIE_Enable();
+
+    return ERROR_OK;
+}
+
+ERROR_t RTC_SetMsOfDay(const u32_t msOfDay) {
+    u32_t u32SecondOfDay = msOfDay / RTC_MS_PER_SECOND;
+
+    if(u32SecondOfDay >= RTC_SECONDS_PER_DAY) {
+        return ERROR_OUT_OF_RANGE;
+    }
+
+    GIE_Disable();
+
+    RTC_secondOfDay = u32SecondOfDay;
+    RTC_msOfSecond = (u16_t)(msOfDay % RTC_MS_PER_SECOND);
+    RTC_isTimeSet = TRUE;
+
+    RTC_FindPlan(u32SecondOfDay);
+
+    GIE_Enable();
+
+    return ERROR_OK;
+}
+
+ERROR_t RTC_GetTime(RTC_TIME_t * const pTime) {
+    u32_t u32SecondOfDay = 0;
+
+    if(NULL == pTime) {
+        return ERROR_NULL_POINTER;
+    }
+
+    /* 32-bit read is not atomic on AVR */
+    GIE_Disable();
+    u32SecondOfDay = RTC_secondOfDay;
+    GIE_Enable();
+
+    pTime->hours = (u8_t)(u32SecondOfDay / 3600UL);
+    pTime->minutes = (u8_t)((u32SecondOfDay / 60UL) % 60UL);
+    pTime->seconds = (u8_t)(u32SecondOfDay % 60UL);
+
+    return RTC_isTimeSet ? ERROR_OK : ERROR_NOT_INITIALIZED;
+}
+
+ERROR_t RTC_GetMsOfDay(u32_t * const pMsOfDay) {
+    u32_t u32SecondOfDay = 0;
+    u16_t u16Ms = 0;
+
+    if(NULL == pMsOfDay) {
+        return ERROR_NULL_POINTER;
+    }
+
+    /* The second and its milliseconds of the same tick */
+    GIE_Disable();
+    u32SecondOfDay = RTC_secondOfDay;
+    u16Ms = RTC_msOfSecond;
+    GIE_Enable();
+
+    *pMsOfDay = (u32SecondOfDay * RTC_MS_PER_SECOND) + u16Ms;
+
+    return RTC_isTimeSet ? ERROR_OK : ERROR_NOT_INITIALIZED;
+}
+
+RTC_PLAN_t RTC_GetPlan(void) {
+    return RTC_plan;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PRIVATE FUNCTIONS                                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Find the plan at a time of the day, and the entry that starts next
+ * @details The plan is the one of the last entry started, or of the last entry
+ *          of the day before the first start. Called with the interrupts 
+ *          disabled.
+ ******************************************************************************/
+static void RTC_FindPlan(const u32_t u32SecondOfDay) {
+    u8_t u8Current = 0;
+    u8_t i = 0;
+
+    if(0 == countRtcSchedule) {
+        return;
+    }
+
+    u8Current = countRtcSchedule - 1U;
+
+    for(i = 0; i < countRtcSchedule; ++i) {
+        if(RTC_TO_SECONDS(rtcSchedule[i].start) <= u32SecondOfDay) {
+            u8Current = i;
+        }
+    }
+
+    RTC_plan = rtcSchedule[u8Current].plan;
+
+    RTC_nextEntry = (u8Current + 1U < countRtcSchedule) ? (u8Current + 1U) : 0;
+    RTC_nextEntrySecond = RTC_TO_SECONDS(rtcSchedule[RTC_nextEntry].start);
+}
+
+/******************************************************************************
+ * @brief   Count the time of day, and switch the plan on schedule
+ * @details Tick callback, called every millisecond. Does nothing but count, 
+ *          except once per second.
+ ******************************************************************************/
+static void RTC_Tick(void) {
+    RTC_msOfSecond++;
+    if(RTC_msOfSecond < RTC_MS_PER_SECOND) {
+        return;
+    }
+    RTC_msOfSecond = 0;
+
+    RTC_secondOfDay++;
+    if(RTC_secondOfDay >= RTC_SECONDS_PER_DAY) {
+        RTC_secondOfDay = 0;
+    }
+
+    if( RTC_isTimeSet && (0 != countRtcSchedule) && (RTC_secondOfDay == RTC_nextEntrySecond) ) {
+        RTC_plan = rtcSchedule[RTC_nextEntry].plan;
+
+        RTC_nextEntry++;
+        if(RTC_nextEntry >= countRtcSchedule) {
+            RTC_nextEntry = 0;
+        }
+
+        RTC_nextEntrySecond = RTC_TO_SECONDS(rtcSchedule[RTC_nextEntry].start);
+    }
+}
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * @file        RTC.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref RTC.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef RTC_H
+#define RTC_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Timing plans switched by the time of day schedule
+ *****************************************************************************/
+typedef enum {
+    RTC_PLAN_PEAK,
+    RTC_PLAN_OFF_PEAK,
+    RTC_PLAN_NIGHT_FLASH,
+
+    NUM_OF_RTC_PLANS
+}RTC_PLAN_t;
+
+typedef struct {
+    u8_t    hours;          /*!< 0 to 23 */
+    u8_t    minutes;        /*!< 0 to 59 */
+    u8_t    seconds;        /*!< 0 to 59 */
+}RTC_TIME_t;
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the clock and the schedule
+ * @details     The clock counts the milliseconds of the system tick, so it has
+ *              the accuracy of the 32.768 kHz crystal with TIMER_TICK_XTAL.
+ *              Until the time is set, the schedule is not followed and the plan
+ *              is RTC_UNSET_PLAN.
+ * @pre         TIMER_TickInit
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t RTC_Init(void);
+
+/******************************************************************************
+ * @brief       Set the time of day, and the plan scheduled at that time
+ * @param[in]   pTime: the new time
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t RTC_SetTime(const RTC_TIME_t * const pTime);
+
+/******************************************************************************
+ * @brief       Set the time of day to the millisecond, and the plan scheduled at
+ *              that time
+ * @details     Restores a time read by \ref RTC_GetMsOfDay, e.g. after a reset
+ * @param[in]   msOfDay: milliseconds since midnight
+ * @return      ERROR_t: ERROR_OUT_OF_RANGE if not within a day. 
+ *              See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t RTC_SetMsOfDay(const u32_t msOfDay);
+
+/******************************************************************************
+ * @brief       Get the time of day
+ * @param[out]  pTime: the time. Since the power on, if it was never set
+ * @return      ERROR_t: ERROR_NOT_INITIALIZED if the time was never set. 
+ *              See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t RTC_GetTime(RTC_TIME_t * const pTime);
+
+/******************************************************************************
+ * @brief       Get the time of day to the millisecond
+ * @param[out]  pMsOfDay: milliseconds since midnight. Since the power on, if 
+ *              the time was never set
+ * @return      ERROR_t: ERROR_NOT_INITIALIZED if the time was never set. 
+ *              See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t RTC_GetMsOfDay(u32_t * const pMsOfDay);
+
+/******************************************************************************
+ * @brief       Get the plan of the schedule
+ * @details     Updated by the tick when a scheduled time is reached, so 
+ *              reading it does not read the clock. Can be called from an ISR.
+ * @return      RTC_PLAN_t: the plan that applies now
+ *****************************************************************************/
+RTC_PLAN_t RTC_GetPlan(void);
+
+
+#endif      /* RTC_H */
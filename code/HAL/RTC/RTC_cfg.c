@@ -0,0 +1,34 @@
+/******************************************************************************
+ * @file        RTC_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref RTC.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "RTC.h"
+#include "RTC_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const RTC_SCHEDULE_CONFIGS_t rtcSchedule[] = {
+    {{ 6, 0, 0}, RTC_PLAN_OFF_PEAK},
+    {{ 7, 0, 0}, RTC_PLAN_PEAK},
+    {{10, 0, 0}, RTC_PLAN_OFF_PEAK},
+    {{16, 0, 0}, RTC_PLAN_PEAK},
+    {{19, 0, 0}, RTC_PLAN_OFF_PEAK},
+    {{23, 0, 0}, RTC_PLAN_NIGHT_FLASH},
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     DO NOT CHANGE ANYTHING BELOW THIS LINE                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const u8_t countRtcSchedule = sizeof(rtcSchedule) / sizeof(rtcSchedule[0]);
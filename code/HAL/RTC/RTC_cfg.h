@@ -0,0 +1,40 @@
+/******************************************************************************
+ * @file        RTC_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref RTC.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef RTC_CFG_H
+#define RTC_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Plan used while the time is not set, see \ref RTC_PLAN_t */
+#define RTC_UNSET_PLAN      RTC_PLAN_PEAK
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   A plan starts at its time, and lasts until the time of the next 
+ *          entry, or of the first entry of the next day
+ ******************************************************************************/
+typedef struct {
+    RTC_TIME_t  start;
+    RTC_PLAN_t  plan;
+}RTC_SCHEDULE_CONFIGS_t;
+
+/*!< Sorted by start time */
+extern const RTC_SCHEDULE_CONFIGS_t rtcSchedule[];
+extern const u8_t countRtcSchedule;
+
+#endif      /* RTC_CFG_H */
@@ -0,0 +1,252 @@
+/**********************************************************************************
+ * @file        SPEED.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Vehicle speed and headway trap on a pair of loops, timestamped by
+ *              the input capture unit of Timer 1
+ * @version     1.0.0
+ * @date        2026-10-19
+ **********************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+#include "../../MCAL/DIO/DIO.h"
+#include "../../MCAL/GIE/GIE.h"
+#include "../../MCAL/TIMER/TIMER.h"
+#include "SPEED.h"
+#include "SPEED_cfg.h"
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            PRIVATE FUNCTIONS PROTOTYPES                      */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+static void SPEED_Capture(void);
+static void SPEED_Overflow(void);
+static u32_t SPEED_ExtendCapture(const u16_t u16Capture);
+static void SPEED_ReadLoops(BOOL_t * const pIsAActive, BOOL_t * const pIsBActive);
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            MACRO LIKE FUNCTIONS                              */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+#define SPEED_TICKS_PER_MS          ( SPEED_TICKS_PER_SEC / 1000UL )
+
+/*!< speed [0.1 km/h] = SPEED_KMH_X10_FACTOR / travel [ticks]           */
+#define SPEED_KMH_X10_FACTOR        ( SPEED_LOOP_SPACING_MM * 36UL * SPEED_TICKS_PER_MS )
+
+#define SPEED_MAX_TRAVEL_TICKS      ( SPEED_MAX_TRAVEL_MS * SPEED_TICKS_PER_MS )
+#define SPEED_BUFFER_MASK           ( SPEED_BUFFER_SIZE - 1U )
+
+#if (SPEED_BUFFER_SIZE & SPEED_BUFFER_MASK)
+#error "SPEED_BUFFER_SIZE must be a power of 2"
+#endif
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                                  TYPEDEFS                                    */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< Raw measurement as stored by the ISR, in Timer 1 ticks    */
+typedef struct {
+    u32_t   timestamp;
+    u32_t   travelTicks;
+    u32_t   headwayTicks;
+}SPEED_RAW_t;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                           PRIVATE GLOBALS VARIABLES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< Upper 16 bits of the Timer 1 time base                */
+static volatile u32_t SPEED_overflows = 0;
+
+/*!< Ring buffer: written by the capture ISR only at head, read by SPEED_Read only at tail */
+static SPEED_RAW_t SPEED_buffer[SPEED_BUFFER_SIZE];
+static volatile u8_t SPEED_head = 0;
+static volatile u8_t SPEED_tail = 0;
+static volatile u16_t SPEED_dropped = 0;
+
+/*!< State of the loops at the previous capture            */
+static BOOL_t SPEED_wasAActive = FALSE;
+static BOOL_t SPEED_wasBActive = FALSE;
+
+/*!< Vehicle between loop A and loop B                     */
+static BOOL_t SPEED_isTravelling = FALSE;
+static u32_t SPEED_entryA = 0;
+static u32_t SPEED_previousEntryA = 0;
+
+/*!< Occupancy of loop A by the vehicles that left it: whole milliseconds, and 
+     the ticks left over, carried to the next vehicle                       */
+static volatile u32_t SPEED_occupiedMs = 0;
+static u32_t SPEED_occupiedTicks = 0;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PUBLIC FUNCTIONS                                */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+ERROR_t SPEED_Init(void) {
+    SPEED_head = 0;
+    SPEED_tail = 0;
+    SPEED_dropped = 0;
+    SPEED_overflows = 0;
+    SPEED_isTravelling = FALSE;
+    SPEED_entryA = 0;
+    SPEED_occupiedMs = 0;
+    SPEED_occupiedTicks = 0;
+
+    SPEED_ReadLoops(&SPEED_wasAActive, &SPEED_wasBActive);
+
+    TIMER1_Init(0, SPEED_TIMER_CLOCK, TIMER_MODE_NORMAL, NO_OC, TIMER_OCA);
+
+    /* The XOR output is HIGH when the loops differ: its next change is a falling edge */
+    TIMER1_ConfigCapture( (SPEED_wasAActive != SPEED_wasBActive) ? TIMER_ICP_FALLING : TIMER_ICP_RISING, TRUE);
+
+    TIMER1_EnableOverflowInterrupt(SPEED_Overflow);
+    TIMER1_EnableCaptureInterrupt(SPEED_Capture);
+
+    return ERROR_OK;
+}
+
+ERROR_t SPEED_Read(SPEED_RECORD_t * const pRecord) {
+    const SPEED_RAW_t * pRaw = NULL;
+    u32_t u32Value = 0;
+
+    if(NULL == pRecord) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(SPEED_head == SPEED_tail) {
+        return ERROR_NOK;
+    }
+
+    pRaw = &SPEED_buffer[SPEED_tail];
+
+    pRecord->timestamp = pRaw->timestamp;
+
+    u32Value = SPEED_KMH_X10_FACTOR / pRaw->travelTicks;
+    pRecord->speedKmhX10 = (u32Value > 0xFFFFUL) ? 0xFFFFU : (u16_t)u32Value;
+
+    u32Value = pRaw->headwayTicks / SPEED_TICKS_PER_MS;
+    pRecord->headwayMs = (u32Value > 0xFFFFUL) ? 0xFFFFU : (u16_t)u32Value;
+
+    /* Release the slot only after it is copied */
+    SPEED_tail = (SPEED_tail + 1U) & SPEED_BUFFER_MASK;
+
+    return ERROR_OK;
+}
+
+u16_t SPEED_GetDropped(void) {
+    return SPEED_dropped;
+}
+
+u32_t SPEED_GetOccupancyMs(void) {
+    u32_t u32OccupiedMs = 0;
+    u32_t u32Ticks = 0;
+
+    /* The time base, and the vehicle over the loop, must not change meanwhile: 
+       TCNT1 is read without enabling the interrupts */
+    GIE_Disable();
+    u32OccupiedMs = SPEED_occupiedMs;
+    if(SPEED_wasAActive) {
+        u32Ticks = SPEED_occupiedTicks + (SPEED_ExtendCapture(TIMER1_GetTimerValue()) - SPEED_entryA);
+    }
+    GIE_Enable();
+
+    return u32OccupiedMs + (u32Ticks / SPEED_TICKS_PER_MS);
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PRIVATE FUNCTIONS                               */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Extend a 16-bit capture to the 32-bit time base
+ * @details Called from the capture ISR, so an overflow that happened before 
+ *          the capture may still be pending. It is counted if the captured 
+ *          value is in the lower half (it wrapped before the capture).
+ ******************************************************************************/
+static u32_t SPEED_ExtendCapture(const u16_t u16Capture) {
+    u32_t u32Overflows = SPEED_overflows;
+
+    if( TIMER1_IsOverflowPending() && (u16Capture < 0x8000U) ) {
+        ++u32Overflows;
+    }
+
+    return (u32Overflows << 16) | u16Capture;
+}
+
+static void SPEED_ReadLoops(BOOL_t * const pIsAActive, BOOL_t * const pIsBActive) {
+    STATE_t state = LOW;
+
+    DIO_ReadPin(DIO_PINS_SPEED_LOOP_A, &state);
+    *pIsAActive = (SPEED_LOOP_ACTIVE_LEVEL == state) ? TRUE : FALSE;
+
+    DIO_ReadPin(DIO_PINS_SPEED_LOOP_B, &state);
+    *pIsBActive = (SPEED_LOOP_ACTIVE_LEVEL == state) ? TRUE : FALSE;
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              ISR CALLBACKS                                   */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Any loop changed: ICR1 holds the time of the change
+ ******************************************************************************/
+static void SPEED_Capture(void) {
+    u32_t u32Now = SPEED_ExtendCapture(TIMER1_GetCaptureValue());
+    u32_t u32Travel = 0;
+    BOOL_t isAActive = FALSE, isBActive = FALSE;
+    u8_t u8Next = 0;
+
+    SPEED_ReadLoops(&isAActive, &isBActive);
+
+    /* Wait for the opposite change of the XOR output */
+    TIMER1_SetCaptureEdge( (isAActive != isBActive) ? TIMER_ICP_FALLING : TIMER_ICP_RISING );
+
+    if( !isAActive && SPEED_wasAActive ) {
+        SPEED_occupiedTicks += u32Now - SPEED_entryA;
+        SPEED_occupiedMs += SPEED_occupiedTicks / SPEED_TICKS_PER_MS;
+        SPEED_occupiedTicks %= SPEED_TICKS_PER_MS;
+    }
+
+    if( isAActive && !SPEED_wasAActive ) {
+        SPEED_previousEntryA = SPEED_entryA;
+        SPEED_entryA = u32Now;
+        SPEED_isTravelling = TRUE;
+    }
+
+    if( isBActive && !SPEED_wasBActive && SPEED_isTravelling ) {
+        SPEED_isTravelling = FALSE;
+        u32Travel = u32Now - SPEED_entryA;
+
+        if( (u32Travel > 0) && (u32Travel <= SPEED_MAX_TRAVEL_TICKS) ) {
+            u8Next = (SPEED_head + 1U) & SPEED_BUFFER_MASK;
+
+            if(u8Next == SPEED_tail) {
+                SPEED_dropped++;
+            } else {
+                SPEED_buffer[SPEED_head].timestamp = SPEED_entryA;
+                SPEED_buffer[SPEED_head].travelTicks = u32Travel;
+                SPEED_buffer[SPEED_head].headwayTicks = SPEED_entryA - SPEED_previousEntryA;
+                SPEED_head = u8Next;
+            }
+        }
+    }
+
+    SPEED_wasAActive = isAActive;
+    SPEED_wasBActive = isBActive;
+}
+
+/*!< Every 65536 ticks of Timer 1 */
+static void SPEED_Overflow(void) {
+    SPEED_overflows++;
+}
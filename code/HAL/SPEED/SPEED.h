@@ -0,0 +1,74 @@
+/******************************************************************************
+ * @file        SPEED.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref SPEED.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef SPEED_H
+#define SPEED_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   One vehicle measured by the speed trap (fixed point, no float)
+ *****************************************************************************/
+typedef struct {
+    u32_t   timestamp;      /*!< Loop A activation, in Timer 1 ticks (see SPEED_TICKS_PER_SEC)  */
+    u16_t   speedKmhX10;    /*!< Speed in 0.1 km/h                                              */
+    u16_t   headwayMs;      /*!< Time since the previous vehicle on loop A, saturated at 65535  */
+}SPEED_RECORD_t;
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/********************************************************************************
+ * @brief       Start the speed trap on Timer 1 input capture (ICP1)
+ * @details     Timer 1 runs free at SPEED_TIMER_CLOCK and every loop edge is 
+ *              latched in ICR1 by hardware, so the timestamp does not depend on
+ *              the interrupt latency. The overflow interrupt extends it to 32 bits.
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ ********************************************************************************/
+ERROR_t SPEED_Init(void);
+
+/********************************************************************************
+ * @brief       Take the oldest measured vehicle out of the ring buffer
+ * @details     Never blocks. The ISR only stores raw tick counts, the fixed
+ *              point conversion is done here in the caller's context.
+ * @param[out]  pRecord: the vehicle. See \ref SPEED_RECORD_t
+ * @return      ERROR_t: ERROR_OK if a vehicle was read, ERROR_NOK if the buffer 
+ *              is empty, ERROR_NULL_POINTER.
+ * @par         Example:
+ *              @code
+ *              while(ERROR_OK == SPEED_Read(&vehicle)) {
+ *                  // use vehicle.speedKmhX10 and vehicle.headwayMs
+ *              }
+ *              @endcode
+ ********************************************************************************/
+ERROR_t SPEED_Read(SPEED_RECORD_t * const pRecord);
+
+/********************************************************************************
+ * @brief       Number of vehicles lost because the ring buffer was full
+ ********************************************************************************/
+u16_t SPEED_GetDropped(void);
+
+/********************************************************************************
+ * @brief       Time loop A was occupied since SPEED_Init, the vehicle over it 
+ *              included
+ * @details     Timed by the captures of the loop edges, to the tick. The 
+ *              occupancy of a period is the difference of two reads, it wraps 
+ *              after 49 days of occupancy
+ * @return      u32_t: the time in milliseconds
+ ********************************************************************************/
+u32_t SPEED_GetOccupancyMs(void);
+
+#endif      /* SPEED_H */
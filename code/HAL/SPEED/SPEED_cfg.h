@@ -0,0 +1,53 @@
+/******************************************************************************
+ * @file        SPEED_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref SPEED.c
+ * @details     Wiring: both loop detector outputs go to an XOR gate whose 
+ *              output drives ICP1 (PD6), so any change of either loop is an 
+ *              edge to capture. Each loop is also read on its own DIO pin 
+ *              (DIO_PINS_SPEED_LOOP_A / DIO_PINS_SPEED_LOOP_B) to tell which
+ *              one changed.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef SPEED_CFG_H
+#define SPEED_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    CHANGE THE FOLLOWING TO YOUR NEEDS                      */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Distance between the leading edges of loop A and loop B, in mm
+ * OPTIONS: 1000 to 20000 mm
+ ******************************************************************************/
+#define SPEED_LOOP_SPACING_MM       (4000UL)
+
+/******************************************************************************
+ * @brief   Clock of Timer 1 and its rate. F_CPU / 8 gives 0.5 us resolution
+ *          and an overflow every 32.768 ms.
+ ******************************************************************************/
+#define SPEED_TIMER_CLOCK           F_CPU_8
+#define SPEED_TICKS_PER_SEC         (F_CPU / 8UL)
+
+/******************************************************************************
+ * @brief   A vehicle taking longer than this from loop A to loop B is not
+ *          measured (stopped or queued traffic)
+ ******************************************************************************/
+#define SPEED_MAX_TRAVEL_MS         (2000UL)
+
+/******************************************************************************
+ * @brief   Size of the ring buffer of measured vehicles
+ * @warning Must be a power of 2
+ ******************************************************************************/
+#define SPEED_BUFFER_SIZE           (8U)
+
+/******************************************************************************
+ * @brief   Logic level of a loop detector output while a vehicle is over it
+ ******************************************************************************/
+#define SPEED_LOOP_ACTIVE_LEVEL     LOW
+
+#endif      /* SPEED_CFG_H */
@@ -0,0 +1,259 @@
+/**********************************************************************************
+ * @file        SSEG.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Multiplexed seven segment display, through a BCD decoder
+ * @details     The number is turned once, when it changes, into one image of 
+ *              the decoder inputs and one image of the selects per digit. The 
+ *              tick ISR only copies the images of the next digit to the ports.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **********************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+
+#include "../../MCAL/DIO/DIO.h"
+#include "../../MCAL/GIE/GIE.h"
+#include "../../MCAL/TIMER/TIMER.h"
+
+#include "SSEG.h"
+#include "SSEG_cfg.h"
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            PRIVATE FUNCTIONS PROTOTYPES                      */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+static void SSEG_Refresh(void);
+static u8_t SSEG_GetDataImage(const u8_t code);
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            MACRO LIKE FUNCTIONS                              */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< SSEG_number when the display is blank */
+#define SSEG_NO_NUMBER              (0xFFFFU)
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                           PRIVATE GLOBALS VARIABLES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< Ports of the decoder inputs and of the selects, NULL until SSEG_Init */
+static volatile u8_t * SSEG_pDataPort = NULL;
+static volatile u8_t * SSEG_pSelectPort = NULL;
+
+/*!< Bits of the ports driven by the display, and of each decoder input */
+static u8_t SSEG_dataMask = 0;
+static u8_t SSEG_selectMask = 0;
+static u8_t SSEG_bcdMasks[SSEG_BCD_BITS];
+
+/*!< Images written by the refresh, per digit */
+static u8_t SSEG_dataImages[SSEG_NUM_OF_DIGITS];
+static u8_t SSEG_selectImages[SSEG_NUM_OF_DIGITS];
+
+/*!< The digit lit by the last refresh */
+static u8_t SSEG_digit = 0;
+
+/*!< The number shown, and the largest one that fits */
+static u16_t SSEG_number = SSEG_NO_NUMBER;
+static u16_t SSEG_maxNumber = 0;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PUBLIC FUNCTIONS                                */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+ERROR_t SSEG_Init(void) {
+    ERROR_t error = ERROR_OK;
+    volatile u8_t * pDataPort = NULL;
+    volatile u8_t * pSelectPort = NULL;
+    volatile u8_t * pPort = NULL;
+    volatile u8_t * pPinReg = NULL;
+    u8_t au8SelectMasks[SSEG_NUM_OF_DIGITS];
+    u8_t u8Mask = 0;
+    u8_t i = 0, j = 0;
+
+    if(SSEG_NUM_OF_DIGITS != countSsegDigitsConfigured) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    SSEG_dataMask = 0;
+    SSEG_selectMask = 0;
+
+    for(i = 0; (i < SSEG_BCD_BITS) && (ERROR_OK == error); ++i) {
+        error |= DIO_GetPinRegisters(ssegBcdPins[i], &pPort, &pPinReg, &u8Mask);
+
+        if(NULL == pDataPort) {
+            pDataPort = pPort;
+        } else if(pPort != pDataPort) {
+            error |= ERROR_INVALID_PARAMETER;
+        } else {
+            /* Same port */
+        }
+
+        SSEG_bcdMasks[i] = u8Mask;
+        SSEG_dataMask |= u8Mask;
+    }
+
+    for(i = 0; (i < SSEG_NUM_OF_DIGITS) && (ERROR_OK == error); ++i) {
+        error |= DIO_GetPinRegisters(ssegDigitConfigs[i].selectPin, &pPort, &pPinReg, &u8Mask);
+
+        if(NULL == pSelectPort) {
+            pSelectPort = pPort;
+        } else if(pPort != pSelectPort) {
+            error |= ERROR_INVALID_PARAMETER;
+        } else {
+            /* Same port */
+        }
+
+        au8SelectMasks[i] = u8Mask;
+        SSEG_selectMask |= u8Mask;
+    }
+
+    if(ERROR_OK != error) {
+        return error;
+    }
+
+    SSEG_maxNumber = 1;
+
+    for(i = 0; i < SSEG_NUM_OF_DIGITS; ++i) {
+        SSEG_maxNumber *= 10U;
+
+        /* The other digits off first: a pin shared by two digits takes the level of this one */
+        SSEG_selectImages[i] = 0;
+
+        for(j = 0; j < SSEG_NUM_OF_DIGITS; ++j) {
+            if( (j != i) && (LOW == ssegDigitConfigs[j].selectLevel) ) {
+                SSEG_selectImages[i] |= au8SelectMasks[j];
+            }
+        }
+
+        if(HIGH == ssegDigitConfigs[i].selectLevel) {
+            SSEG_selectImages[i] |= au8SelectMasks[i];
+        } else {
+            SSEG_selectImages[i] &= (u8_t)~au8SelectMasks[i];
+        }
+
+        SSEG_dataImages[i] = SSEG_GetDataImage(SSEG_BLANK_CODE);
+    }
+
+    SSEG_maxNumber -= 1U;
+    SSEG_number = SSEG_NO_NUMBER;
+    SSEG_digit = 0;
+
+    GIE_Disable();
+    SSEG_pDataPort = pDataPort;
+    SSEG_pSelectPort = pSelectPort;
+    GIE_Enable();
+
+    error |= TIMER_TickAddCallback(SSEG_Refresh);
+
+    return error;
+}
+
+ERROR_t SSEG_SetNumber(const u16_t number) {
+    u8_t au8Images[SSEG_NUM_OF_DIGITS];
+    u16_t u16Rest = number;
+    u8_t u8Code = 0;
+    u8_t i = 0;
+
+    if(NULL == SSEG_pDataPort) {
+        return ERROR_NOT_INITIALIZED;
+    }
+
+    if(number > SSEG_maxNumber) {
+        return ERROR_OUT_OF_RANGE;
+    }
+
+    if(number == SSEG_number) {
+        return ERROR_OK;
+    }
+
+    /* From the units up, the units digit shows a 0 */
+    for(i = SSEG_NUM_OF_DIGITS; i > 0; --i) {
+        if( (0 == u16Rest) && (i != SSEG_NUM_OF_DIGITS) ) {
+            u8Code = SSEG_BLANK_CODE;
+        } else {
+            u8Code = (u8_t)(u16Rest % 10U);
+        }
+
+        u16Rest /= 10U;
+        au8Images[i - 1U] = SSEG_GetDataImage(u8Code);
+    }
+
+    /* The refresh never shows a mix of two numbers */
+    GIE_Disable();
+    for(i = 0; i < SSEG_NUM_OF_DIGITS; ++i) {
+        SSEG_dataImages[i] = au8Images[i];
+    }
+    GIE_Enable();
+
+    SSEG_number = number;
+
+    return ERROR_OK;
+}
+
+void SSEG_Clear(void) {
+    u8_t u8Image = SSEG_GetDataImage(SSEG_BLANK_CODE);
+    u8_t i = 0;
+
+    if(SSEG_NO_NUMBER == SSEG_number) {
+        return;
+    }
+
+    GIE_Disable();
+    for(i = 0; i < SSEG_NUM_OF_DIGITS; ++i) {
+        SSEG_dataImages[i] = u8Image;
+    }
+    GIE_Enable();
+
+    SSEG_number = SSEG_NO_NUMBER;
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PRIVATE FUNCTIONS                               */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Light the next digit
+ * @details Tick callback, with the interrupts disabled: the read-modify-write
+ *          of the ports is not interrupted. The code is written before the 
+ *          select, the next digit shows the previous code for one cycle only
+ ******************************************************************************/
+static void SSEG_Refresh(void) {
+    u8_t u8Digit = SSEG_digit + 1U;
+
+    if(u8Digit >= SSEG_NUM_OF_DIGITS) {
+        u8Digit = 0;
+    }
+
+    SSEG_digit = u8Digit;
+
+    *SSEG_pDataPort = (*SSEG_pDataPort & (u8_t)~SSEG_dataMask) | SSEG_dataImages[u8Digit];
+    *SSEG_pSelectPort = (*SSEG_pSelectPort & (u8_t)~SSEG_selectMask) | SSEG_selectImages[u8Digit];
+}
+
+/******************************************************************************
+ * @brief   Image of the decoder inputs for a code
+ * @param   code: 0 to 9, or SSEG_BLANK_CODE
+ * @return  u8_t: the bits of the data port
+ ******************************************************************************/
+static u8_t SSEG_GetDataImage(const u8_t code) {
+    u8_t u8Image = 0;
+    u8_t i = 0;
+
+    for(i = 0; i < SSEG_BCD_BITS; ++i) {
+        if(BIT_READ(code, i)) {
+            u8Image |= SSEG_bcdMasks[i];
+        }
+    }
+
+    return u8Image;
+}
@@ -0,0 +1,46 @@
+/******************************************************************************
+ * @file        SSEG.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref SSEG.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef SSEG_H
+#define SSEG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the multiplexing of the display, blank
+ * @details     The tick ISR lights the next digit every millisecond: each 
+ *              digit is refreshed at 1000 / SSEG_NUM_OF_DIGITS Hz. A refresh 
+ *              is two port writes of images computed by \ref SSEG_SetNumber, 
+ *              about 40 cycles.
+ * @pre         JTAG disabled (JTAGEN fuse) when the pins are on PC2 to PC5
+ * @return      ERROR_t: ERROR_INVALID_PARAMETER if the pins of the BCD inputs,
+ *              or of the selects, are not on one port. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t SSEG_Init(void);
+
+/******************************************************************************
+ * @brief       Show a number, the leading zeros blanked
+ * @details     Returns at once when the number is shown already, so it can be
+ *              called on every pass of a loop
+ * @param[in]   number: up to 10^SSEG_NUM_OF_DIGITS - 1
+ * @return      ERROR_t: ERROR_OUT_OF_RANGE if the number does not fit. See 
+ *              \ref ERROR_t
+ *****************************************************************************/
+ERROR_t SSEG_SetNumber(const u16_t number);
+
+/******************************************************************************
+ * @brief       Blank all the digits
+ * @details     Returns at once when the display is blank already
+ *****************************************************************************/
+void SSEG_Clear(void);
+
+#endif      /* SSEG_H */
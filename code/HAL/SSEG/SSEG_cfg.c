@@ -0,0 +1,39 @@
+/******************************************************************************
+ * @file        SSEG_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref SSEG.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../MCAL/DIO/DIO.h"
+#include "SSEG.h"
+#include "SSEG_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Tens and units of the pedestrian countdown, on complementary drivers */
+SSEG_DIGIT_CONFIGS_t ssegDigitConfigs[] = {
+    {DIO_PINS_SSEG_SELECT, HIGH},
+    {DIO_PINS_SSEG_SELECT, LOW},
+};
+
+const DIO_PINS_t ssegBcdPins[SSEG_BCD_BITS] = {
+    DIO_PINS_SSEG_BCD_A,
+    DIO_PINS_SSEG_BCD_B,
+    DIO_PINS_SSEG_BCD_C,
+    DIO_PINS_SSEG_BCD_D,
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     DO NOT CHANGE ANYTHING BELOW THIS LINE                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const u8_t countSsegDigitsConfigured = sizeof(ssegDigitConfigs) / sizeof(ssegDigitConfigs[0]);
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * @file        SSEG_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref SSEG.c
+ * @details     Wiring: the 4 BCD inputs of a decoder (74HC4511 or 7447) are 
+ *              shared by all the digits, the segments of each digit are 
+ *              driven by the decoder and its common pin by its select pin. 
+ *              Two digits can share one select pin with complementary 
+ *              drivers, one lit when the pin is HIGH, the other when LOW.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef SSEG_CFG_H
+#define SSEG_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Digits of the display, one per element of ssegDigitConfigs */
+#define SSEG_NUM_OF_DIGITS      (2U)
+
+/*!< Code that blanks a digit: the 74HC4511 blanks 10 to 15, the 7447 blanks 15 */
+#define SSEG_BLANK_CODE         (0x0FU)
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Inputs of the decoder, A to D */
+#define SSEG_BCD_BITS           (4U)
+
+/******************************************************************************
+ * @brief   Configuration of a digit
+ * @details - selectPin:   The pin of its common, through a driver
+ *          - selectLevel: The level of the pin that lights the digit
+ ******************************************************************************/
+typedef struct {
+    DIO_PINS_t  selectPin;
+    STATE_t     selectLevel;
+}SSEG_DIGIT_CONFIGS_t;
+
+/*!< The digits, the most significant first. The select pins on one port */
+extern SSEG_DIGIT_CONFIGS_t ssegDigitConfigs[];
+extern const u8_t countSsegDigitsConfigured;
+
+/*!< The inputs of the decoder, A (LSB) first, on one port */
+extern const DIO_PINS_t ssegBcdPins[SSEG_BCD_BITS];
+
+#endif      /* SSEG_CFG_H */
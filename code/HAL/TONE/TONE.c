@@ -0,0 +1,122 @@
+/**********************************************************************************
+ * @file        TONE.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Accessible pedestrian signal: the locator and walk tones
+ * @details     The pitch is made by the hardware, the tick timer toggles OC2.
+ *              The tick ISR counts the milliseconds of the tone, and switches 
+ *              the toggling at the start and at the end of each beep only.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **********************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+
+#include "../../MCAL/GIE/GIE.h"
+#include "../../MCAL/TIMER/TIMER.h"
+
+#include "TONE.h"
+#include "TONE_cfg.h"
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                            PRIVATE FUNCTIONS PROTOTYPES                      */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+static void TONE_Sequence(void);
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                           PRIVATE GLOBALS VARIABLES                          */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/*!< Beeps of the tone played, NULL when silent */
+static const TONE_CONFIGS_t * volatile TONE_pConfig = NULL;
+
+/*!< The tone played, TONE_NONE until TONE_Init */
+static TONE_t TONE_tone = TONE_NONE;
+
+/*!< Time since the start of the last beep */
+static volatile u16_t TONE_ms = 0;
+
+/*!< The toggling is on */
+static BOOL_t TONE_isOn = FALSE;
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PUBLIC FUNCTIONS                                */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+ERROR_t TONE_Init(void) {
+    GIE_Disable();
+    TONE_pConfig = NULL;
+    GIE_Enable();
+
+    TONE_tone = TONE_NONE;
+
+    return TIMER_TickAddCallback(TONE_Sequence);
+}
+
+ERROR_t TONE_Play(const TONE_t tone) {
+    const TONE_CONFIGS_t * pConfig = NULL;
+    u8_t i = 0;
+
+    if(tone == TONE_tone) {
+        return ERROR_OK;
+    }
+
+    if(TONE_NONE != tone) {
+        for(i = 0; (i < countTonesConfigured) && (NULL == pConfig); ++i) {
+            if(tone == toneConfigs[i].tone) {
+                pConfig = &toneConfigs[i];
+            }
+        }
+
+        if(NULL == pConfig) {
+            return ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    GIE_Disable();
+    TONE_pConfig = pConfig;
+    TONE_ms = 0;
+    GIE_Enable();
+
+    TONE_tone = tone;
+
+    return ERROR_OK;
+}
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PRIVATE FUNCTIONS                               */
+/*                                                                              */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Start or end the beep
+ * @details Tick callback, with the interrupts disabled. A switch refused by 
+ *          the timer, while its previous write crosses to the crystal clock,
+ *          is done on the next tick
+ ******************************************************************************/
+static void TONE_Sequence(void) {
+    const TONE_CONFIGS_t * pConfig = TONE_pConfig;
+    BOOL_t isOn = FALSE;
+    u16_t u16Ms = TONE_ms;
+
+    if(NULL != pConfig) {
+        isOn = (u16Ms < pConfig->beepMs) ? TRUE : FALSE;
+
+        ++u16Ms;
+        if(u16Ms >= pConfig->periodMs) {
+            u16Ms = 0;
+        }
+
+        TONE_ms = u16Ms;
+    }
+
+    if( (isOn != TONE_isOn) && (ERROR_OK == TIMER_TickSetToggle(isOn)) ) {
+        TONE_isOn = isOn;
+    }
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * @file        TONE.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref TONE.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef TONE_H
+#define TONE_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Tones of the accessible pedestrian signal, their beeps are set in 
+ *          TONE_cfg.c
+ *****************************************************************************/
+typedef enum {
+    TONE_LOCATOR,                   /*!< Where the push button is       */
+    TONE_WALK,                      /*!< The walk is on                 */
+
+    NUM_OF_TONES,
+    TONE_NONE = NUM_OF_TONES        /*!< Silent                         */
+}TONE_t;
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the sequencing of the tones, silent
+ * @details     The piezo is driven by the toggling of OC2 by the tick timer,
+ *              at TIMER_TICK_HZ / 2. The tick ISR only switches the toggling 
+ *              on and off at the edges of the beeps, see 
+ *              \ref TIMER_TickSetToggle
+ * @pre         \ref TIMER_TickInit
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t TONE_Init(void);
+
+/******************************************************************************
+ * @brief       Play a tone until another one is played
+ * @details     A new tone starts with a beep. Returns at once when the tone 
+ *              plays already, so it can be called on every pass of a loop
+ * @param[in]   tone: See \ref TONE_t, TONE_NONE for silence
+ * @return      ERROR_t: ERROR_INVALID_PARAMETER if the tone is not in 
+ *              TONE_cfg.c. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t TONE_Play(const TONE_t tone);
+
+#endif      /* TONE_H */
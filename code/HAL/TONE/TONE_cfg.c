@@ -0,0 +1,34 @@
+/******************************************************************************
+ * @file        TONE_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref TONE.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "TONE.h"
+#include "TONE_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @note    The locator is a short beep each second. The walk is the rapid 
+ *          tick, 10 beeps per second.
+ *****************************************************************************/
+TONE_CONFIGS_t toneConfigs[] = {
+    {TONE_LOCATOR,  100,    1000},
+    {TONE_WALK,     30,     100},
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     DO NOT CHANGE ANYTHING BELOW THIS LINE                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const u8_t countTonesConfigured = sizeof(toneConfigs) / sizeof(toneConfigs[0]);
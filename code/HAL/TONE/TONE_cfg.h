@@ -0,0 +1,30 @@
+/******************************************************************************
+ * @file        TONE_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref TONE.c
+ * @details     Wiring: the piezo between OC2 (PD7) and ground. Its pitch is 
+ *              the toggling of the tick timer: 512 Hz with TIMER_TICK_XTAL, 
+ *              500 Hz with TIMER_TICK_CPU.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef TONE_CFG_H
+#define TONE_CFG_H
+
+/******************************************************************************
+ * @brief   Beeps of a tone
+ * @details - tone:     The tone. See \ref TONE_t
+ *          - beepMs:   Length of a beep
+ *          - periodMs: Time from a beep to the next one, more than beepMs
+ ******************************************************************************/
+typedef struct {
+    TONE_t  tone;
+    u16_t   beepMs;
+    u16_t   periodMs;
+}TONE_CONFIGS_t;
+
+extern TONE_CONFIGS_t toneConfigs[];
+extern const u8_t countTonesConfigured;
+
+#endif      /* TONE_CFG_H */
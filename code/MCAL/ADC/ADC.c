@@ -0,0 +1,215 @@
+/**************************************************************************
+ * @file        ADC.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       ADC driver for Atmega32 microcontroller.
+ * @details     The ADC runs in free running mode: a conversion starts as soon
+ *              as the previous one completes, and the conversion complete ISR
+ *              is the only code that touches the ADC after the init.
+ *              The ISR adds the result to the exponential average of its 
+ *              channel and selects the channel after the next one: when the
+ *              ISR runs, the next conversion has already started with the 
+ *              previous selection.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ***************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+
+#include "../GIE/GIE.h"
+
+#include "ADC_reg.h"
+#include "ADC.h"
+#include "ADC_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                      PRIVATE FUNCTIONS PROTOTYPES                          */
+/*                                                                            */                              
+/*----------------------------------------------------------------------------*/
+static ERROR_t ADC_ReadIndex(const ADC_CHANNEL_t channel, s8_t * const ptr_s8Index);
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                            MACRO LIKE FUNCTIONS                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define ASSERT_CHANNEL(channel)     ( channel < NUM_OF_ADC_CHANNELS )
+
+/*!< The averages hold up to 1023 << ADC_AVERAGING_SHIFT */
+#if ADC_AVERAGING_SHIFT > 6
+#error "ADC_AVERAGING_SHIFT must not exceed 6"
+#endif
+
+/*!< The channels of the round robin */
+#define ADC_MAX_CHANNELS            (8U)
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                           PRIVATE GLOBALS VARIABLES                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Averages scaled by 2^ADC_AVERAGING_SHIFT, indexed as adcChannels */
+static volatile u16_t ADC_averages[ADC_MAX_CHANNELS];
+
+/*!< Index of the conversion running, and of the channel selected for the next one */
+static u8_t ADC_runningIndex = 0;
+static u8_t ADC_selectedIndex = 0;
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PUBLIC FUNCTIONS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+ERROR_t ADC_Init(void) {
+    u8_t i = 0;
+
+    if( (0 == countAdcChannels) || (countAdcChannels > ADC_MAX_CHANNELS) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    for(i = 0; i < countAdcChannels; ++i) {
+        if( !ASSERT_CHANNEL(adcChannels[i]) ) {
+            return ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    GIE_Disable();
+
+    /* Stop any conversion before changing the setup */
+    ADCSRA = 0;
+
+    for(i = 0; i < countAdcChannels; ++i) {
+        ADC_averages[i] = 0;
+    }
+
+    ADC_runningIndex = 0;
+    ADC_selectedIndex = 0;
+
+    ADMUX = (u8_t)((u8_t)ADC_REFERENCE << REFS0) | (u8_t)adcChannels[0];
+
+    /* Free running */
+    SFIOR &= (u8_t)~SFIOR_ADTS_MASK;
+
+    ADCSRA = (1U << ADEN) | (1U << ADSC) | (1U << ADATE) | (1U << ADIF) | 
+             (1U << ADIE) | (u8_t)ADC_PRESCALER;
+
+    GIE_Enable();
+
+    return ERROR_OK;
+}
+
+ERROR_t ADC_Read(const ADC_CHANNEL_t channel, u16_t * const pValue) {
+    ERROR_t error = ERROR_OK;
+    u16_t u16Average = 0;
+    s8_t i = 0;
+
+    if(NULL == pValue) {
+        return ERROR_NULL_POINTER;
+    }
+
+    error |= ADC_ReadIndex(channel, &i);
+    if(i < 0) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    /* Read again if the ISR changed the average between its two bytes */
+    do {
+        u16Average = ADC_averages[i];
+    } while(u16Average != ADC_averages[i]);
+
+    *pValue = u16Average >> ADC_AVERAGING_SHIFT;
+
+    return error;
+}
+
+ERROR_t ADC_ReadMillivolts(const ADC_CHANNEL_t channel, u16_t * const pMillivolts) {
+    ERROR_t error = ERROR_OK;
+    u16_t u16Value = 0;
+
+    if(NULL == pMillivolts) {
+        return ERROR_NULL_POINTER;
+    }
+
+    error |= ADC_Read(channel, &u16Value);
+
+    *pMillivolts = (u16_t)( ((u32_t)u16Value * ADC_VREF_MV) >> 10 );
+
+    return error;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PRIVATE FUNCTIONS                                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief Get the index of the channel in the adcChannels array
+ * 
+ * @param[in] channel: The channel to get the index of
+ * @param[in] ptr_s8Index: The pointer to the index of the channel. 
+ *              Options:
+ *                    -1: The channel is not in the adcChannels array
+ *                  >= 0: The index of the channel in the adcChannels array
+ * @return ERROR_t: The error status of the function.
+ ******************************************************************************/
+static ERROR_t ADC_ReadIndex(const ADC_CHANNEL_t channel, s8_t * const ptr_s8Index) {
+    u8_t i = 0;
+
+    if(NULL == ptr_s8Index) {
+        return ERROR_NULL_POINTER;
+    }
+
+    *ptr_s8Index = -1;
+
+    if( !ASSERT_CHANNEL(channel) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    for(i = 0; i < countAdcChannels; ++i) {
+        if(channel == adcChannels[i]) {
+            *ptr_s8Index = i;
+        }
+    }
+
+    return ERROR_OK;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                              ISR FUNCTIONS                                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/* ISR of ADC Conversion Complete */
+void __vector_16(void) __attribute__((signal));
+void __vector_16(void) {
+    u16_t u16Sample = 0;
+    u16_t u16Average = 0;
+
+    GIE_Disable();
+
+    /* ADCL first, it locks ADCH until read */
+    u16Sample = ADCL;
+    u16Sample |= (u16_t)ADCH << 8;
+
+    /* average += sample - average / 2^shift */
+    u16Average = ADC_averages[ADC_runningIndex];
+    u16Average += u16Sample - (u16Average >> ADC_AVERAGING_SHIFT);
+    ADC_averages[ADC_runningIndex] = u16Average;
+
+    /* The conversion that just started uses the channel selected last time */
+    ADC_runningIndex = ADC_selectedIndex;
+
+    ADC_selectedIndex++;
+    if(ADC_selectedIndex >= countAdcChannels) {
+        ADC_selectedIndex = 0;
+    }
+
+    ADMUX = (u8_t)(ADMUX & (u8_t)~ADMUX_MUX_MASK) | (u8_t)adcChannels[ADC_selectedIndex];
+
+    GIE_Enable();
+}
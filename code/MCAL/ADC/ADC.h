@@ -0,0 +1,96 @@
+/******************************************************************************
+ * @file        ADC.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref ADC.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef ADC_H
+#define ADC_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Single ended input channels, ADCn is on pin PAn
+ *****************************************************************************/
+typedef enum {
+    ADC_CHANNEL_0,
+    ADC_CHANNEL_1,
+    ADC_CHANNEL_2,
+    ADC_CHANNEL_3,
+    ADC_CHANNEL_4,
+    ADC_CHANNEL_5,
+    ADC_CHANNEL_6,
+    ADC_CHANNEL_7,
+
+    NUM_OF_ADC_CHANNELS
+}ADC_CHANNEL_t;
+
+/******************************************************************************
+ * @brief   Voltage reference of the conversions
+ *****************************************************************************/
+typedef enum {
+    ADC_REF_AREF,               /*!< External voltage on the AREF pin          */
+    ADC_REF_AVCC,               /*!< AVCC, with a capacitor on AREF            */
+    ADC_REF_INTERNAL_2V56 = 3,  /*!< Internal 2.56 V, with a capacitor on AREF */
+}ADC_REFERENCE_t;
+
+/******************************************************************************
+ * @brief   Division of F_CPU giving the ADC clock, which must be 50-200 kHz 
+ *          for 10-bit results
+ *****************************************************************************/
+typedef enum {
+    ADC_PRESCALER_2 = 1,
+    ADC_PRESCALER_4,
+    ADC_PRESCALER_8,
+    ADC_PRESCALER_16,
+    ADC_PRESCALER_32,
+    ADC_PRESCALER_64,
+    ADC_PRESCALER_128,
+}ADC_PRESCALER_t;
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the free running conversions of the configured channels
+ * @details     The ADC converts without stop, the conversion complete ISR 
+ *              stores each result in the average of its channel and selects the
+ *              next channel. The application never starts nor waits for a 
+ *              conversion.
+ *              Each ISR costs a few tens of cycles, once per conversion (13 ADC
+ *              clocks, ~104 us with ADC_PRESCALER_128 at 16 MHz).
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t ADC_Init(void);
+
+/******************************************************************************
+ * @brief       Read the averaged result of a channel
+ * @details     Lock free, can be called from an ISR.
+ * @param[in]   channel: a configured channel. See \ref ADC_CHANNEL_t
+ * @param[out]  pValue: 0 to 1023, the average of the last 2^ADC_AVERAGING_SHIFT
+ *              conversions (exponential average)
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t ADC_Read(const ADC_CHANNEL_t channel, u16_t * const pValue);
+
+/******************************************************************************
+ * @brief       Read the averaged voltage of a channel
+ * @details     Lock free, can be called from an ISR.
+ * @param[in]   channel: a configured channel. See \ref ADC_CHANNEL_t
+ * @param[out]  pMillivolts: the voltage in mV, relative to ADC_VREF_MV
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t ADC_ReadMillivolts(const ADC_CHANNEL_t channel, u16_t * const pMillivolts);
+
+
+#endif      /* ADC_H */
@@ -0,0 +1,34 @@
+/******************************************************************************
+ * @file        ADC_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref ADC.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "ADC.h"
+#include "ADC_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*****************************************************************************
+ * @note    PA0 to PA5 drive the lamps, ADC6 and ADC7 sense the current of the
+ *          cars' and the pedestrians' signal heads.
+ *****************************************************************************/
+const ADC_CHANNEL_t adcChannels[] = {
+    ADC_CHANNEL_6,
+    ADC_CHANNEL_7,
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     DO NOT CHANGE ANYTHING BELOW THIS LINE                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const u8_t countAdcChannels = sizeof(adcChannels) / sizeof(adcChannels[0]);
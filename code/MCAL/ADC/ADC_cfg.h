@@ -0,0 +1,38 @@
+/******************************************************************************
+ * @file        ADC_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref ADC.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef ADC_CFG_H
+#define ADC_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Reference, see \ref ADC_REFERENCE_t, and its voltage in mV */
+#define ADC_REFERENCE           ADC_REF_INTERNAL_2V56
+#define ADC_VREF_MV             (2560UL)
+
+/*!< 16 MHz / 128 = 125 kHz ADC clock, see \ref ADC_PRESCALER_t */
+#define ADC_PRESCALER           ADC_PRESCALER_128
+
+/*!< Each result is averaged over ~2^ADC_AVERAGING_SHIFT conversions, up to 6 */
+#define ADC_AVERAGING_SHIFT     (4U)
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Channels converted in turn. Their pins must be inputs without pullup */
+extern const ADC_CHANNEL_t adcChannels[];
+extern const u8_t countAdcChannels;
+
+#endif      /* ADC_CFG_H */
@@ -0,0 +1,55 @@
+/**************************************************************************
+ * @file        ADC_reg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       ADC Registers of ATmega32 MCU
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **************************************************************************/
+#ifndef ADC_REG_H
+#define ADC_REG_H
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              CHANGE THIS PART ONLY FOR NEW DEVICES                         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define ADMUX      (* ((volatile u8_t *) 0x27) )    /* ADC Multiplexer Selection Register */
+#define ADCSRA     (* ((volatile u8_t *) 0x26) )    /* ADC Control and Status Register A */
+#define ADCH       (* ((volatile u8_t *) 0x25) )    /* ADC Data Register High */
+#define ADCL       (* ((volatile u8_t *) 0x24) )    /* ADC Data Register Low */
+#define SFIOR      (* ((volatile u8_t *) 0x50) )    /* Special Function IO Register */
+
+enum {
+	MUX0,                                           /* Analog Channel Selection Bit 0 */
+	MUX1,                                           /* Analog Channel Selection Bit 1 */
+	MUX2,                                           /* Analog Channel Selection Bit 2 */
+	MUX3,                                           /* Analog Channel Selection Bit 3 */
+	MUX4,                                           /* Analog Channel Selection Bit 4 */
+	ADLAR,                                          /* ADC Left Adjust Result */
+	REFS0,                                          /* Reference Selection Bit 0 */
+	REFS1,                                          /* Reference Selection Bit 1 */
+};	/* ADMUX	*/
+
+enum {
+	ADPS0,                                          /* ADC Prescaler Select Bit 0 */
+	ADPS1,                                          /* ADC Prescaler Select Bit 1 */
+	ADPS2,                                          /* ADC Prescaler Select Bit 2 */
+	ADIE,                                           /* ADC Interrupt Enable */
+	ADIF,                                           /* ADC Interrupt Flag */
+	ADATE,                                          /* ADC Auto Trigger Enable */
+	ADSC,                                           /* ADC Start Conversion */
+	ADEN,                                           /* ADC Enable */
+};	/* ADCSRA	*/
+
+enum {
+	ADTS0 = 5,                                      /* ADC Auto Trigger Source Bit 0 */
+	ADTS1,                                          /* ADC Auto Trigger Source Bit 1 */
+	ADTS2,                                          /* ADC Auto Trigger Source Bit 2 */
+};	/* SFIOR	*/
+
+#define ADMUX_MUX_MASK      (0x1FU)                 /* MUX4:0 */
+#define SFIOR_ADTS_MASK     (0xE0U)                 /* ADTS2:0, 000 is free running */
+
+#endif    /* ADC_REG_H */
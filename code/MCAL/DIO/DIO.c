@@ -48,6 +48,37 @@ static volatile u8_t * PIN_reg[NUM_OF_PORTS] = {
     &PINA, &PINB, &PINC, &PIND,
 };
 
+/*-----------------------------------------------------------------------------*/
+/*                                                                             */
+/*                                 EARLY INIT                                  */
+/*                                                                             */
+/*-----------------------------------------------------------------------------*/
+
+/*******************************************************************************
+ *  @brief   Drive the signal outputs to their safe state right after reset
+ *  @details Placed in .init3 by the linker: it runs after .init2 has set the 
+ *           stack and the zero register, and before .init4 copies .data and 
+ *           clears .bss, so it only writes constants. Naked: the init sections
+ *           fall through into each other, there is no call and no return.
+ *           From the reset vector: jmp (3 cycles), .init2 (6 cycles), then the
+ *           4 ldi/out pairs: the outputs are safe after at most 17 cycles, ~1.1 us at
+ *           16 MHz. The pins are tri-stated only during the start-up delay of
+ *           the fuses, before any code runs.
+ *           The 17 cycles are counted from the generated code, not measured.
+ *           To measure them, trigger a scope on the rising edge of /RESET and 
+ *           time the first edge of PA0: the time less the start-up delay of 
+ *           the fuses is the time of the code.
+ *           The PORT registers are written before the DDR registers: the pins 
+ *           leave the high impedance state at their safe level.
+ ******************************************************************************/
+void DIO_EarlyInit(void) __attribute__((naked, used, section(".init3")));
+void DIO_EarlyInit(void) {
+    PORTA = DIO_EARLY_PORTA;
+    DDRA = DIO_EARLY_DDRA;
+    PORTD = DIO_EARLY_PORTD;
+    DDRD = DIO_EARLY_DDRD;
+}
+
 /*-----------------------------------------------------------------------------*/
 /*                                                                             */
 /*                         PRIVATE FUNCTIONS PROTOTYPES                        */
@@ -75,13 +106,18 @@ static ERROR_t DIO_IsPinAvailable(const DIO_PINS_t name, s8_t * const s8_ptrToIn
 /*******************************************************************************
  * @details Initialize DIO pins to a specific direction (input or output), pullup 
  *          or not according to the configuration in the DIO_cfg.h file.  
+ *          The outputs keep their level, set by the early init.
  ******************************************************************************/
 ERROR_t DIO_Init(void) {
     ERROR_t error = ERROR_OK;
     u8_t i = 0;
 
     for(i = 0; i < countPinsConfigured; ++i) {
-        DIO_InitPin(pinConfigs[i].name, pinConfigs[i].direction, pinConfigs[i].pullup);
+        if(DIO_OUTPUT == pinConfigs[i].direction) {
+            error |= DIO_SetPinDirection(pinConfigs[i].name, DIO_OUTPUT);
+        } else {
+            error |= DIO_InitPin(pinConfigs[i].name, pinConfigs[i].direction, pinConfigs[i].pullup);
+        }
     }
 
     return error;
@@ -277,6 +313,27 @@ ERROR_t DIO_SetNibbleValue(const DIO_PINS_t startPinName, const u8_t value) {
     return error;
 }
 
+ERROR_t DIO_GetPinRegisters(const DIO_PINS_t pin, volatile u8_t ** const ppPortReg, 
+                            volatile u8_t ** const ppPinReg, u8_t * const pMask) {
+    ERROR_t error = ERROR_OK;
+    s8_t i = -1;
+
+    if( (NULL == ppPortReg) || (NULL == ppPinReg) || (NULL == pMask) ) {
+        return ERROR_NULL_POINTER;
+    }
+
+    error |= DIO_IsPinAvailable(pin, &i);
+
+    if( (ERROR_OK == error) && (i >= 0) ) {
+        *ppPortReg = PORT_reg[pinConfigs[i].port];
+        *ppPinReg = PIN_reg[pinConfigs[i].port];
+        *pMask = (u8_t)(1U << pinConfigs[i].pin);
+    } else {
+        error |= ERROR_INVALID_PARAMETER;
+    }
+
+    return error;
+}
 
 
 /*----------------------------------------------------------------------------*/
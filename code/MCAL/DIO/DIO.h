@@ -32,6 +32,49 @@ typedef enum {
 
     /* BUTTONS  */
     DIO_PINS_PEDESTRIAN_BUTTON,
+
+    /* Corridor sync pulse */
+    DIO_PINS_SYNC,
+
+    /* Emergency vehicle preemption */
+    DIO_PINS_PREEMPT,
+
+    /* Vehicle detectors */
+    DIO_PINS_CARS_DETECTOR,
+    DIO_PINS_SPEED_LOOP_A,
+    DIO_PINS_SPEED_LOOP_B,
+    DIO_PINS_SPEED_ICP,
+
+    /* Current sense of the signal heads */
+    DIO_PINS_CARS_CURRENT,
+    DIO_PINS_PEDESTRIAN_CURRENT,
+
+    /* Command link */
+    DIO_PINS_UART_RX,
+    DIO_PINS_UART_TX,
+
+    /* Hardware flasher of the failsafe */
+    DIO_PINS_FAILSAFE_YELLOW,
+    DIO_PINS_FAILSAFE_RED,
+
+    /* Pedestrian countdown display */
+    DIO_PINS_SSEG_BCD_A,
+    DIO_PINS_SSEG_BCD_B,
+    DIO_PINS_SSEG_BCD_C,
+    DIO_PINS_SSEG_BCD_D,
+    DIO_PINS_SSEG_SELECT,
+
+    /* Accessible pedestrian signal */
+    DIO_PINS_TONE,
+
+    /* TWI bus */
+    DIO_PINS_TWI_SCL,
+    DIO_PINS_TWI_SDA,
+
+    /* SPI bus, and the latch of the lamp shift registers */
+    DIO_PINS_SPI_MOSI,
+    DIO_PINS_SPI_SCK,
+    DIO_PINS_LAMPS_LATCH,
 } DIO_PINS_t;
 
 /******************************************************************************
@@ -366,4 +409,18 @@ ERROR_t DIO_SetClrPortDirection(const DIO_PINS_t pinInThePort, const DIO_DIR_t d
  ******************************************************************************/ 
 ERROR_t DIO_SetNibbleValue(const DIO_PINS_t startPin, const u8_t value);
 
+/*******************************************************************************
+ * @brief       Get the registers and the bit mask of a pin
+ * @details     For time critical code, e.g. a tick ISR reading a whole port, 
+ *              that can not afford the configuration lookup on every access.
+ *              The registers are looked up once, then read directly.
+ * @param[in]   pin: The pin. See \ref DIO_PINS_t for options.
+ * @param[out]  ppPortReg: The PORTx register of the pin
+ * @param[out]  ppPinReg: The PINx register of the pin
+ * @param[out]  pMask: The bit of the pin in these registers
+ * @return      ERROR_t: Error code. See \ref ERROR_t for more information.
+ ******************************************************************************/
+ERROR_t DIO_GetPinRegisters(const DIO_PINS_t pin, volatile u8_t ** const ppPortReg, 
+                            volatile u8_t ** const ppPinReg, u8_t * const pMask);
+
 #endif      /* DIO_H */
\ No newline at end of file
@@ -28,19 +28,70 @@
  ******************************************************************************/
 DIO_PIN_CONFIGS_t  pinConfigs[] = {
 
-    /* Cars LEDs */
-    {DIO_PINS_CAR_LED_R, DIO_PIN_0, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
-    {DIO_PINS_CAR_LED_Y, DIO_PIN_1, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
-    {DIO_PINS_CAR_LED_G, DIO_PIN_2, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
+    /* Cars LEDs: on PORTA, so PB0/PB1 stay free for the T0/T1 counter inputs */
+    {DIO_PINS_CAR_LED_R, DIO_PIN_0, DIO_PORT_A, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_CAR_LED_Y, DIO_PIN_1, DIO_PORT_A, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_CAR_LED_G, DIO_PIN_2, DIO_PORT_A, DIO_OUTPUT, DIO_PULLUP_OFF},
 
     /* Pedestrian LEDs */
-    {DIO_PINS_PEDESTRIAN_LED_R, DIO_PIN_3, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
-    {DIO_PINS_PEDESTRIAN_LED_Y, DIO_PIN_4, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
-    {DIO_PINS_PEDESTRIAN_LED_G, DIO_PIN_5, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_PEDESTRIAN_LED_R, DIO_PIN_3, DIO_PORT_A, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_PEDESTRIAN_LED_Y, DIO_PIN_4, DIO_PORT_A, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_PEDESTRIAN_LED_G, DIO_PIN_5, DIO_PORT_A, DIO_OUTPUT, DIO_PULLUP_OFF},
 
 
     /* BUTTON  */
     {DIO_PINS_PEDESTRIAN_BUTTON, DIO_PIN_2, DIO_PORT_D, DIO_INPUT, DIO_PULLUP_ON},
+
+    /* Corridor sync: INT1, open collector line pulsed low once per cycle */
+    {DIO_PINS_SYNC, DIO_PIN_3, DIO_PORT_D, DIO_INPUT, DIO_PULLUP_ON},
+
+    /* Preemption receiver: INT2, open collector output held low while an 
+       emergency vehicle comes */
+    {DIO_PINS_PREEMPT, DIO_PIN_2, DIO_PORT_B, DIO_INPUT, DIO_PULLUP_ON},
+
+    /* Vehicle detectors: T0 pin, open-collector output of the loop detector card */
+    {DIO_PINS_CARS_DETECTOR, DIO_PIN_0, DIO_PORT_B, DIO_INPUT, DIO_PULLUP_ON},
+
+    /* Speed trap: loop A, loop B and their XOR on ICP1. Loop B on MISO, PD7 is
+       the tone output */
+    {DIO_PINS_SPEED_LOOP_A, DIO_PIN_3, DIO_PORT_B, DIO_INPUT, DIO_PULLUP_ON},
+    {DIO_PINS_SPEED_LOOP_B, DIO_PIN_6, DIO_PORT_B, DIO_INPUT, DIO_PULLUP_ON},
+    {DIO_PINS_SPEED_ICP,    DIO_PIN_6, DIO_PORT_D, DIO_INPUT, DIO_PULLUP_OFF},
+
+    /* Current sense: ADC6 and ADC7, a pullup would offset the reading */
+    {DIO_PINS_CARS_CURRENT,       DIO_PIN_6, DIO_PORT_A, DIO_INPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_PEDESTRIAN_CURRENT, DIO_PIN_7, DIO_PORT_A, DIO_INPUT, DIO_PULLUP_OFF},
+
+    /* Command link: RXD and TXD, taken over by the USART once enabled. The 
+       pullup holds RXD idle while no cable is plugged */
+    {DIO_PINS_UART_RX, DIO_PIN_0, DIO_PORT_D, DIO_INPUT,  DIO_PULLUP_ON},
+    {DIO_PINS_UART_TX, DIO_PIN_1, DIO_PORT_D, DIO_OUTPUT, DIO_PULLUP_OFF},
+
+    /* Failsafe flasher: OC1A and OC1B, low until the failsafe takes Timer 1 */
+    {DIO_PINS_FAILSAFE_YELLOW, DIO_PIN_5, DIO_PORT_D, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_FAILSAFE_RED,    DIO_PIN_4, DIO_PORT_D, DIO_OUTPUT, DIO_PULLUP_OFF},
+
+    /* Countdown display: the BCD decoder on the JTAG pins, PC6/PC7 hold the 
+       tick crystal. One select for both digits, on complementary drivers */
+    {DIO_PINS_SSEG_BCD_A,  DIO_PIN_2, DIO_PORT_C, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_SSEG_BCD_B,  DIO_PIN_3, DIO_PORT_C, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_SSEG_BCD_C,  DIO_PIN_4, DIO_PORT_C, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_SSEG_BCD_D,  DIO_PIN_5, DIO_PORT_C, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_SSEG_SELECT, DIO_PIN_1, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
+
+    /* Piezo: OC2, toggled by the tick timer, low while the tone is off */
+    {DIO_PINS_TONE, DIO_PIN_7, DIO_PORT_D, DIO_OUTPUT, DIO_PULLUP_OFF},
+
+    /* TWI bus: SCL and SDA, taken over by the TWI once enabled. The pullups 
+       hold the bus idle without chips, the external resistors set the edges */
+    {DIO_PINS_TWI_SCL, DIO_PIN_0, DIO_PORT_C, DIO_INPUT, DIO_PULLUP_ON},
+    {DIO_PINS_TWI_SDA, DIO_PIN_1, DIO_PORT_C, DIO_INPUT, DIO_PULLUP_ON},
+
+    /* SPI master: MOSI and SCK. SS is the latch of the 74HC595 chain, it must 
+       stay an output, MISO is the loop B input */
+    {DIO_PINS_SPI_MOSI,    DIO_PIN_5, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_SPI_SCK,     DIO_PIN_7, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
+    {DIO_PINS_LAMPS_LATCH, DIO_PIN_4, DIO_PORT_B, DIO_OUTPUT, DIO_PULLUP_OFF},
 };
 
 
@@ -9,6 +9,25 @@
 #ifndef DIO_CFG_H
 #define DIO_CFG_H
 
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Safe state of the signal outputs, written right after reset by the
+ *          early init of DIO.c, before the C runtime: the red lamps on, the 
+ *          other lamps off, the failsafe flasher pins low. With lamps on a 
+ *          74HC595 chain, PA0 high holds its /OE off until the first latch
+ * @warning Must agree with the outputs of pinConfigs, DIO_Init keeps the level
+ *          of the outputs. The other pins stay inputs until DIO_Init
+ *****************************************************************************/
+#define DIO_EARLY_DDRA      (0x3FU)     /*!< PA0..PA5: the lamps            */
+#define DIO_EARLY_PORTA     (0x09U)     /*!< PA0, PA3: the red lamps        */
+#define DIO_EARLY_DDRD      (0x30U)     /*!< PD4, PD5: the failsafe flasher */
+#define DIO_EARLY_PORTD     (0x00U)
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*              DO NOT CHANGE ANYTHING BELOW THIS COMMENT                     */
@@ -0,0 +1,484 @@
+/**************************************************************************
+ * @file        EEPROM.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       EEPROM driver for Atmega32 microcontroller.
+ * @details     Writes never block: the bytes are queued, and the EE_RDY 
+ *              interrupt writes them one by one while the application runs.
+ *              Reads are served from the queue, a small read cache, or the 
+ *              EEPROM when it is not busy.
+ *              Frequently updated counters are written round-robin in a ring 
+ *              of slots, to spread the wear. At startup the slot holding the 
+ *              highest valid value is the last one written.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ***************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+
+#include "../GIE/GIE.h"
+
+#include "EEPROM_reg.h"
+#include "EEPROM.h"
+#include "EEPROM_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                      PRIVATE FUNCTIONS PROTOTYPES                          */
+/*                                                                            */                              
+/*----------------------------------------------------------------------------*/
+static ERROR_t EEPROM_ReadIndex(const EEPROM_COUNTER_t counter, s8_t * const ptr_s8Index);
+static u8_t EEPROM_ReadHardware(const u16_t address);
+static ERROR_t EEPROM_ReadAvailable(const u16_t address, u8_t * const pData);
+static ERROR_t EEPROM_Enqueue(const u16_t address, const u8_t data);
+static void EEPROM_LoadCounter(const u8_t index);
+static ERROR_t EEPROM_StoreCounter(const u8_t index);
+static void EEPROM_WriteNext(void);
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                            MACRO LIKE FUNCTIONS                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define ASSERT_ADDRESS(address, length) ( ((u32_t)(address) + (length)) <= EEPROM_SIZE )
+#define ASSERT_COUNTER(counter)         ( counter < NUM_OF_EEPROM_COUNTERS )
+
+#define EEPROM_QUEUE_MASK               ( EEPROM_QUEUE_SIZE - 1U )
+#define EEPROM_CACHE_MASK               ( EEPROM_CACHE_SIZE - 1U )
+
+/*!< Marks an empty line of the read cache  */
+#define EEPROM_NO_ADDRESS               ( 0xFFFFU )
+
+/*!< Erased slots (0xFF) and torn writes do not match their checksum */
+#define EEPROM_SLOT_CHECKSUM(b)         ( (u8_t)~(u8_t)((b)[0] + (b)[1] + (b)[2] + (b)[3]) )
+
+#if (EEPROM_QUEUE_SIZE & EEPROM_QUEUE_MASK) || (EEPROM_QUEUE_SIZE > 128U)
+#error "EEPROM_QUEUE_SIZE must be a power of 2, up to 128"
+#endif
+
+#if (EEPROM_CACHE_SIZE & EEPROM_CACHE_MASK)
+#error "EEPROM_CACHE_SIZE must be a power of 2"
+#endif
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                           PRIVATE GLOBALS VARIABLES                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Write queue: filled at head by the application, emptied at tail by the ISR.
+     An address is queued once at most */
+static u16_t EEPROM_queueAddress[EEPROM_QUEUE_SIZE];
+static u8_t EEPROM_queueData[EEPROM_QUEUE_SIZE];
+static volatile u8_t EEPROM_queueHead = 0;
+static volatile u8_t EEPROM_queueTail = 0;
+
+/*!< Read cache: the line of an address is (address & EEPROM_CACHE_MASK) */
+static u16_t EEPROM_cacheAddress[EEPROM_CACHE_SIZE];
+static u8_t EEPROM_cacheData[EEPROM_CACHE_SIZE];
+
+/*!< Value of each counter, the slot of its next write and its adds not stored */
+static u32_t EEPROM_counterValue[NUM_OF_EEPROM_COUNTERS];
+static u8_t EEPROM_counterSlot[NUM_OF_EEPROM_COUNTERS];
+static u8_t EEPROM_counterAdds[NUM_OF_EEPROM_COUNTERS];
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PUBLIC FUNCTIONS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+ERROR_t EEPROM_Init(void) {
+    ERROR_t error = ERROR_OK;
+    EEPROM_COUNTER_CONFIGS_t * pConfig = NULL;
+    u8_t i = 0;
+
+    GIE_Disable();
+
+    BIT_CLR(EECR, EERIE);
+    EEPROM_queueHead = 0;
+    EEPROM_queueTail = 0;
+
+    GIE_Enable();
+
+    for(i = 0; i < EEPROM_CACHE_SIZE; ++i) {
+        EEPROM_cacheAddress[i] = EEPROM_NO_ADDRESS;
+    }
+
+    /* A write may run from before the reset */
+    while(BIT_IS_SET(EECR, EEWE)) {
+        /* Wait */
+    }
+
+    for(i = 0; i < countEepromCountersConfigured; ++i) {
+        pConfig = &eepromCountersConfigs[i];
+
+        if( !ASSERT_COUNTER(pConfig->counter) || (0 == pConfig->numOfSlots) || (0 == pConfig->addsPerStore) ||
+            !ASSERT_ADDRESS(pConfig->address, (u32_t)pConfig->numOfSlots * EEPROM_SLOT_SIZE) ) {
+            error |= ERROR_INVALID_PARAMETER;
+            continue;
+        }
+
+        EEPROM_LoadCounter(i);
+    }
+
+    return error;
+}
+
+ERROR_t EEPROM_ReadByte(const u16_t address, u8_t * const pData) {
+    ERROR_t error = ERROR_OK;
+
+    if(NULL == pData) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if( !ASSERT_ADDRESS(address, 1U) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    GIE_Disable();
+    error = EEPROM_ReadAvailable(address, pData);
+    GIE_Enable();
+
+    return error;
+}
+
+ERROR_t EEPROM_WriteByte(const u16_t address, const u8_t data) {
+    ERROR_t error = ERROR_OK;
+
+    if( !ASSERT_ADDRESS(address, 1U) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    GIE_Disable();
+    error = EEPROM_Enqueue(address, data);
+    GIE_Enable();
+
+    return error;
+}
+
+ERROR_t EEPROM_ReadBlock(const u16_t address, u8_t * const pData, const u16_t length) {
+    ERROR_t error = ERROR_OK;
+    u16_t i = 0;
+
+    if(NULL == pData) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if( !ASSERT_ADDRESS(address, length) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    /* One byte per critical section, the interrupts are not held off for the whole block */
+    for(i = 0; (i < length) && (ERROR_OK == error); ++i) {
+        GIE_Disable();
+        error = EEPROM_ReadAvailable(address + i, &pData[i]);
+        GIE_Enable();
+    }
+
+    return error;
+}
+
+ERROR_t EEPROM_WriteBlock(const u16_t address, const u8_t * const pData, const u16_t length) {
+    ERROR_t error = ERROR_OK;
+    u16_t i = 0;
+
+    if(NULL == pData) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if( !ASSERT_ADDRESS(address, length) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    GIE_Disable();
+
+    /* All or nothing: check the free entries first */
+    if( length > (u16_t)((EEPROM_queueTail - EEPROM_queueHead - 1U) & EEPROM_QUEUE_MASK) ) {
+        error = ERROR_BUSY;
+    } else {
+        for(i = 0; i < length; ++i) {
+            error |= EEPROM_Enqueue(address + i, pData[i]);
+        }
+    }
+
+    GIE_Enable();
+
+    return error;
+}
+
+BOOL_t EEPROM_IsIdle(void) {
+    return ( (EEPROM_queueHead == EEPROM_queueTail) && BIT_IS_CLEAR(EECR, EEWE) ) ? TRUE : FALSE;
+}
+
+ERROR_t EEPROM_CounterRead(const EEPROM_COUNTER_t counter, u32_t * const pValue) {
+    ERROR_t error = ERROR_OK;
+    s8_t i = 0;
+
+    if(NULL == pValue) {
+        return ERROR_NULL_POINTER;
+    }
+
+    error |= EEPROM_ReadIndex(counter, &i);
+    if(i < 0) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    *pValue = EEPROM_counterValue[counter];
+
+    return error;
+}
+
+ERROR_t EEPROM_CounterAdd(const EEPROM_COUNTER_t counter, const u32_t increment) {
+    ERROR_t error = ERROR_OK;
+    s8_t i = 0;
+
+    error |= EEPROM_ReadIndex(counter, &i);
+    if(i < 0) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    EEPROM_counterValue[counter] += increment;
+
+    /* Kept at the limit until stored: a full queue is retried at the next add */
+    if(EEPROM_counterAdds[counter] < eepromCountersConfigs[i].addsPerStore) {
+        EEPROM_counterAdds[counter]++;
+    }
+
+    if(EEPROM_counterAdds[counter] >= eepromCountersConfigs[i].addsPerStore) {
+        error |= EEPROM_StoreCounter((u8_t)i);
+    }
+
+    return error;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PRIVATE FUNCTIONS                                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief Get the index of the counter in the eepromCountersConfigs array
+ * 
+ * @param[in] counter: The counter to get the index of
+ * @param[in] ptr_s8Index: The pointer to the index of the counter. 
+ *              Options:
+ *                    -1: The counter is not in the eepromCountersConfigs array
+ *                  >= 0: The index of the counter in the eepromCountersConfigs array
+ * @return ERROR_t: The error status of the function.
+ ******************************************************************************/
+static ERROR_t EEPROM_ReadIndex(const EEPROM_COUNTER_t counter, s8_t * const ptr_s8Index) {
+    u8_t i = 0;
+
+    if(NULL == ptr_s8Index) {
+        return ERROR_NULL_POINTER;
+    }
+
+    *ptr_s8Index = -1;
+
+    if( !ASSERT_COUNTER(counter) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    for(i = 0; i < countEepromCountersConfigured; ++i) {
+        if(counter == eepromCountersConfigs[i].counter) {
+            *ptr_s8Index = i;
+        }
+    }
+
+    return ERROR_OK;
+}
+
+/******************************************************************************
+ * @brief   Read a byte from the EEPROM, no write must be running
+ ******************************************************************************/
+static u8_t EEPROM_ReadHardware(const u16_t address) {
+    EEARH = (u8_t)(address >> 8);
+    EEARL = (u8_t)address;
+    BIT_SET(EECR, EERE);
+
+    return EEDR;
+}
+
+/******************************************************************************
+ * @brief   Read a byte from the queue, the cache, or the EEPROM when idle
+ * @details Called with the interrupts disabled
+ ******************************************************************************/
+static ERROR_t EEPROM_ReadAvailable(const u16_t address, u8_t * const pData) {
+    u8_t u8Line = (u8_t)(address & EEPROM_CACHE_MASK);
+    u8_t i = 0;
+
+    /* Newer than the EEPROM */
+    for(i = EEPROM_queueTail; i != EEPROM_queueHead; i = (i + 1U) & EEPROM_QUEUE_MASK) {
+        if(address == EEPROM_queueAddress[i]) {
+            *pData = EEPROM_queueData[i];
+            return ERROR_OK;
+        }
+    }
+
+    if(address == EEPROM_cacheAddress[u8Line]) {
+        *pData = EEPROM_cacheData[u8Line];
+        return ERROR_OK;
+    }
+
+    /* Reading would stall until the end of the write */
+    if(BIT_IS_SET(EECR, EEWE)) {
+        return ERROR_BUSY;
+    }
+
+    *pData = EEPROM_ReadHardware(address);
+
+    EEPROM_cacheAddress[u8Line] = address;
+    EEPROM_cacheData[u8Line] = *pData;
+
+    return ERROR_OK;
+}
+
+/******************************************************************************
+ * @brief   Queue a byte and start the EE_RDY interrupt
+ * @details Called with the interrupts disabled. The cache is updated at once,
+ *          so it always holds the newest value of its addresses.
+ ******************************************************************************/
+static ERROR_t EEPROM_Enqueue(const u16_t address, const u8_t data) {
+    u8_t u8Line = (u8_t)(address & EEPROM_CACHE_MASK);
+    u8_t u8Next = (EEPROM_queueHead + 1U) & EEPROM_QUEUE_MASK;
+    u8_t i = 0;
+
+    for(i = EEPROM_queueTail; i != EEPROM_queueHead; i = (i + 1U) & EEPROM_QUEUE_MASK) {
+        if(address == EEPROM_queueAddress[i]) {
+            break;
+        }
+    }
+
+    if(i != EEPROM_queueHead) {
+        /* Not written yet: replace it */
+        EEPROM_queueData[i] = data;
+    } else if(u8Next == EEPROM_queueTail) {
+        return ERROR_BUSY;
+    } else {
+        EEPROM_queueAddress[EEPROM_queueHead] = address;
+        EEPROM_queueData[EEPROM_queueHead] = data;
+        EEPROM_queueHead = u8Next;
+    }
+
+    EEPROM_cacheAddress[u8Line] = address;
+    EEPROM_cacheData[u8Line] = data;
+
+    BIT_SET(EECR, EERIE);
+
+    return ERROR_OK;
+}
+
+/******************************************************************************
+ * @brief   Find the last slot written of a counter ring
+ * @details The counters only increase, so the valid slot with the highest 
+ *          value is the last one written. Blocking, called from EEPROM_Init.
+ * @param[in] index: index of the counter in eepromCountersConfigs
+ ******************************************************************************/
+static void EEPROM_LoadCounter(const u8_t index) {
+    const EEPROM_COUNTER_CONFIGS_t * pConfig = &eepromCountersConfigs[index];
+    u8_t au8Slot[EEPROM_SLOT_SIZE];
+    u32_t u32Value = 0;
+    u32_t u32Max = 0;
+    BOOL_t isFound = FALSE;
+    u8_t u8Last = 0;
+    u8_t i = 0, j = 0;
+
+    for(i = 0; i < pConfig->numOfSlots; ++i) {
+        for(j = 0; j < EEPROM_SLOT_SIZE; ++j) {
+            au8Slot[j] = EEPROM_ReadHardware(pConfig->address + ((u16_t)i * EEPROM_SLOT_SIZE) + j);
+        }
+
+        if(EEPROM_SLOT_CHECKSUM(au8Slot) != au8Slot[4]) {
+            continue;
+        }
+
+        u32Value =   (u32_t)au8Slot[0]        | ((u32_t)au8Slot[1] << 8) |
+                    ((u32_t)au8Slot[2] << 16) | ((u32_t)au8Slot[3] << 24);
+
+        if( !isFound || (u32Value > u32Max) ) {
+            isFound = TRUE;
+            u32Max = u32Value;
+            u8Last = i;
+        }
+    }
+
+    EEPROM_counterValue[pConfig->counter] = u32Max;
+    EEPROM_counterAdds[pConfig->counter] = 0;
+    EEPROM_counterSlot[pConfig->counter] = isFound ? ((u8Last + 1U) % pConfig->numOfSlots) : 0;
+}
+
+/******************************************************************************
+ * @brief   Queue the value of a counter in its next slot
+ * @details The value is written LSB first and the checksum last, so a reset 
+ *          in the middle leaves a slot that does not match its checksum.
+ * @param[in] index: index of the counter in eepromCountersConfigs
+ ******************************************************************************/
+static ERROR_t EEPROM_StoreCounter(const u8_t index) {
+    const EEPROM_COUNTER_CONFIGS_t * pConfig = &eepromCountersConfigs[index];
+    EEPROM_COUNTER_t counter = pConfig->counter;
+    u32_t u32Value = EEPROM_counterValue[counter];
+    u8_t au8Slot[EEPROM_SLOT_SIZE];
+    ERROR_t error = ERROR_OK;
+
+    au8Slot[0] = (u8_t)u32Value;
+    au8Slot[1] = (u8_t)(u32Value >> 8);
+    au8Slot[2] = (u8_t)(u32Value >> 16);
+    au8Slot[3] = (u8_t)(u32Value >> 24);
+    au8Slot[4] = EEPROM_SLOT_CHECKSUM(au8Slot);
+
+    error = EEPROM_WriteBlock(pConfig->address + ((u16_t)EEPROM_counterSlot[counter] * EEPROM_SLOT_SIZE), 
+                              au8Slot, EEPROM_SLOT_SIZE);
+
+    if(ERROR_OK == error) {
+        EEPROM_counterSlot[counter] = (EEPROM_counterSlot[counter] + 1U) % pConfig->numOfSlots;
+        EEPROM_counterAdds[counter] = 0;
+    }
+
+    return error;
+}
+
+/******************************************************************************
+ * @brief   Start the write of the next queued byte that changes the EEPROM
+ * @details Called from the EE_RDY ISR, so no write is running. The interrupt
+ *          is disabled when the queue is empty.
+ ******************************************************************************/
+static void EEPROM_WriteNext(void) {
+    u16_t u16Address = 0;
+    u8_t u8Data = 0;
+
+    while(EEPROM_queueTail != EEPROM_queueHead) {
+        u16Address = EEPROM_queueAddress[EEPROM_queueTail];
+        u8Data = EEPROM_queueData[EEPROM_queueTail];
+        EEPROM_queueTail = (EEPROM_queueTail + 1U) & EEPROM_QUEUE_MASK;
+
+        /* An unchanged byte costs neither time nor wear */
+        if(EEPROM_ReadHardware(u16Address) != u8Data) {
+            EEDR = u8Data;
+
+            /* EEWE must be set within 4 cycles after EEMWE */
+            BIT_SET(EECR, EEMWE);
+            BIT_SET(EECR, EEWE);
+            return;
+        }
+    }
+
+    BIT_CLR(EECR, EERIE);
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                              ISR FUNCTIONS                                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/* ISR of EEPROM Ready */
+void __vector_17(void) __attribute__((signal));
+void __vector_17(void) {
+    GIE_Disable();
+
+    EEPROM_WriteNext();
+
+    GIE_Enable();
+}
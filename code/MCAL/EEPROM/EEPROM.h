@@ -0,0 +1,126 @@
+/******************************************************************************
+ * @file        EEPROM.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref EEPROM.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef EEPROM_H
+#define EEPROM_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Persistent counters, each one kept in a wear-leveled ring of 
+ *          EEPROM slots set in EEPROM_cfg.c
+ *****************************************************************************/
+typedef enum {
+    EEPROM_COUNTER_CYCLES,              /*!< Cars' greens served            */
+    EEPROM_COUNTER_PED_CALLS,           /*!< Pedestrian calls served        */
+    EEPROM_COUNTER_WATCHDOG_RESETS,     /*!< Resets by the watchdog         */
+    EEPROM_COUNTER_BROWN_OUT_RESETS,    /*!< Resets by the brown-out detector */
+    EEPROM_COUNTER_TRANSIT_CALLS,       /*!< Transit priority calls served  */
+    EEPROM_COUNTER_TRANSIT_SAVED_S,     /*!< Bus delay saved, in seconds    */
+
+    NUM_OF_EEPROM_COUNTERS
+}EEPROM_COUNTER_t;
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Initialize the EEPROM driver and load the persistent counters
+ * @details     Waits for a write started before the reset, and reads the rings
+ *              of the counters. It is the only blocking function of the driver,
+ *              to be called once at startup.
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t EEPROM_Init(void);
+
+/******************************************************************************
+ * @brief       Read a byte without waiting
+ * @details     The byte is taken from the write queue if a write is pending, 
+ *              then from the read cache, then from the EEPROM if it is not 
+ *              busy writing.
+ * @param[in]   address: 0 to EEPROM_SIZE - 1
+ * @param[out]  pData: the byte read
+ * @return      ERROR_t: ERROR_BUSY if the EEPROM is writing and the byte is 
+ *              not cached, try again later. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t EEPROM_ReadByte(const u16_t address, u8_t * const pData);
+
+/******************************************************************************
+ * @brief       Queue a byte to be written in the background
+ * @details     The EE_RDY interrupt writes the queue one byte at a time 
+ *              (~8.5 ms each). A byte already queued for the same address is 
+ *              replaced, and a byte equal to the EEPROM content is not written.
+ * @param[in]   address: 0 to EEPROM_SIZE - 1
+ * @param[in]   data: the byte to write
+ * @return      ERROR_t: ERROR_BUSY if the queue is full. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t EEPROM_WriteByte(const u16_t address, const u8_t data);
+
+/******************************************************************************
+ * @brief       Read a block of bytes without waiting
+ * @param[in]   address: address of the first byte
+ * @param[out]  pData: the bytes read
+ * @param[in]   length: number of bytes
+ * @return      ERROR_t: ERROR_BUSY if any byte is not available now, the 
+ *              block must be read again. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t EEPROM_ReadBlock(const u16_t address, u8_t * const pData, const u16_t length);
+
+/******************************************************************************
+ * @brief       Queue a block of bytes to be written in the background
+ * @details     The block is queued entirely or not at all. The bytes are 
+ *              written in increasing addresses.
+ * @param[in]   address: address of the first byte
+ * @param[in]   pData: the bytes to write
+ * @param[in]   length: number of bytes
+ * @return      ERROR_t: ERROR_BUSY if the queue can not take the whole block.
+ *              See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t EEPROM_WriteBlock(const u16_t address, const u8_t * const pData, const u16_t length);
+
+/******************************************************************************
+ * @brief       Check if all the queued bytes are written
+ * @return      BOOL_t: TRUE when the queue is empty and no write is running
+ *****************************************************************************/
+BOOL_t EEPROM_IsIdle(void);
+
+/******************************************************************************
+ * @brief       Read a persistent counter
+ * @param[in]   counter: See \ref EEPROM_COUNTER_t
+ * @param[out]  pValue: the value of the counter
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t EEPROM_CounterRead(const EEPROM_COUNTER_t counter, u32_t * const pValue);
+
+/******************************************************************************
+ * @brief       Add to a persistent counter
+ * @details     The value is updated at once, and queued in the next slot of the
+ *              ring of the counter every addsPerStore adds, see EEPROM_cfg.h.
+ *              If the queue is full, the value is kept and written with the 
+ *              next add.
+ * @param[in]   counter: See \ref EEPROM_COUNTER_t
+ * @param[in]   increment: value to add
+ * @return      ERROR_t: ERROR_BUSY if the value is due but not queued yet. 
+ *              See \ref ERROR_t
+ * @par         Example:
+ *              @code
+ *              EEPROM_CounterAdd(EEPROM_COUNTER_PED_CALLS, 1);
+ *              @endcode
+ *****************************************************************************/
+ERROR_t EEPROM_CounterAdd(const EEPROM_COUNTER_t counter, const u32_t increment);
+
+
+#endif      /* EEPROM_H */
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * @file        EEPROM_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref EEPROM.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "EEPROM.h"
+#include "EEPROM_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*****************************************************************************
+ * @note    The rings must not overlap, nor overlap the other data stored in 
+ *          the EEPROM. They are placed at the end of the 1 KB EEPROM:
+ *          The EEPROM up to 0x03F is kept for the timing plans of the 
+ *          application, see app_cfg.h.
+ *              0x040 - 0x0DF: transit delay saved (32 slots, 4 adds per store)
+ *              0x0E0 - 0x17F: transit calls       (32 slots, 4 adds per store)
+ *              0x180 - 0x1CF: brown-out resets    (16 slots)
+ *              0x1D0 - 0x21F: watchdog resets     (16 slots)
+ *              0x220 - 0x30F: cycles served       (48 slots, 8 adds per store)
+ *              0x310 - 0x3FF: pedestrian calls    (48 slots, 8 adds per store)
+ *          With 100 000 write cycles per byte, the rings last 20 years of 
+ *          service:
+ *              - cycles and pedestrian calls, at most one per cycle of 20 s:
+ *                  48 * 8 * 100 000 adds = 24 years
+ *              - transit, at most one call per 3 cycles of 20 s (lockout):
+ *                  32 * 4 * 100 000 adds = 24 years
+ *              - resets are stored at once: 1 600 000 resets
+ *          The adds not stored yet are lost on a power cut or a reset, up to 
+ *          7 cycles or pedestrian calls and 3 transit calls.
+ *****************************************************************************/
+EEPROM_COUNTER_CONFIGS_t eepromCountersConfigs[] = {
+    {EEPROM_COUNTER_CYCLES,             0x220, 48, 8},
+    {EEPROM_COUNTER_PED_CALLS,          0x310, 48, 8},
+    {EEPROM_COUNTER_WATCHDOG_RESETS,    0x1D0, 16, 1},
+    {EEPROM_COUNTER_BROWN_OUT_RESETS,   0x180, 16, 1},
+    {EEPROM_COUNTER_TRANSIT_CALLS,      0x0E0, 32, 4},
+    {EEPROM_COUNTER_TRANSIT_SAVED_S,    0x040, 32, 4},
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     DO NOT CHANGE ANYTHING BELOW THIS LINE                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const u8_t countEepromCountersConfigured = sizeof(eepromCountersConfigs) / sizeof(eepromCountersConfigs[0]);
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * @file        EEPROM_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref EEPROM.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef EEPROM_CFG_H
+#define EEPROM_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Bytes waiting to be written. Must be a power of 2, up to 128 */
+#define EEPROM_QUEUE_SIZE       (32U)
+
+/*!< Bytes kept in the read cache (direct mapped). Must be a power of 2 */
+#define EEPROM_CACHE_SIZE       (8U)
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< A slot holds the 4 bytes of the value (LSB first) and their checksum  */
+#define EEPROM_SLOT_SIZE        (5U)
+
+/******************************************************************************
+ * @note    Members:
+ *          - counter:      The counter. See \ref EEPROM_COUNTER_t
+ *          - address:      Address of its first slot
+ *          - numOfSlots:   Slots of the ring, each one takes EEPROM_SLOT_SIZE 
+ *                          bytes
+ *          - addsPerStore: Adds kept in RAM before the value is stored. Every 
+ *                          slot is written once per numOfSlots * addsPerStore 
+ *                          adds, and a reset loses up to addsPerStore - 1 adds
+ *****************************************************************************/
+typedef struct {
+    EEPROM_COUNTER_t    counter;
+    u16_t               address;
+    u8_t                numOfSlots;
+    u8_t                addsPerStore;
+}EEPROM_COUNTER_CONFIGS_t;
+
+extern EEPROM_COUNTER_CONFIGS_t eepromCountersConfigs[];
+extern const u8_t countEepromCountersConfigured;
+
+#endif      /* EEPROM_CFG_H */
@@ -0,0 +1,32 @@
+/**************************************************************************
+ * @file        EEPROM_reg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       EEPROM Registers of ATmega32 MCU
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **************************************************************************/
+#ifndef EEPROM_REG_H
+#define EEPROM_REG_H
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              CHANGE THIS PART ONLY FOR NEW DEVICES                         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define EEARH      (* ((volatile u8_t *) 0x3F) )    /* EEPROM Address Register High */
+#define EEARL      (* ((volatile u8_t *) 0x3E) )    /* EEPROM Address Register Low */
+#define EEDR       (* ((volatile u8_t *) 0x3D) )    /* EEPROM Data Register */
+#define EECR       (* ((volatile u8_t *) 0x3C) )    /* EEPROM Control Register */
+
+enum {
+	EERE,                                           /* EEPROM Read Enable */
+	EEWE,                                           /* EEPROM Write Enable */
+	EEMWE,                                          /* EEPROM Master Write Enable */
+	EERIE,                                          /* EEPROM Ready Interrupt Enable */
+};	/* EECR	*/
+
+#define EEPROM_SIZE     (1024U)                     /* Bytes of EEPROM */
+
+#endif    /* EEPROM_REG_H */
@@ -0,0 +1,116 @@
+/**************************************************************************
+ * @file        SPI.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       SPI master driver for Atmega32 microcontroller.
+ * @details     At the highest clocks, a byte is shifted in fewer CPU cycles 
+ *              than an interrupt takes to enter and return: the transfer 
+ *              polls the flag of each byte and writes the next one at once, 
+ *              so a block leaves the SPI with no gap longer than a few cycles.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ***************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+
+#include "SPI_reg.h"
+#include "SPI.h"
+#include "SPI_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                            MACRO LIKE FUNCTIONS                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< SPR1, SPR0 and SPI2X of each divider */
+#if   (SPI_CLOCK_DIVIDER == 2U)
+#define SPI_SPCR_RATE           (0U)
+#define SPI_SPSR_RATE           (1U << SPI2X)
+#elif (SPI_CLOCK_DIVIDER == 4U)
+#define SPI_SPCR_RATE           (0U)
+#define SPI_SPSR_RATE           (0U)
+#elif (SPI_CLOCK_DIVIDER == 8U)
+#define SPI_SPCR_RATE           (1U << SPR0)
+#define SPI_SPSR_RATE           (1U << SPI2X)
+#elif (SPI_CLOCK_DIVIDER == 16U)
+#define SPI_SPCR_RATE           (1U << SPR0)
+#define SPI_SPSR_RATE           (0U)
+#elif (SPI_CLOCK_DIVIDER == 32U)
+#define SPI_SPCR_RATE           (1U << SPR1)
+#define SPI_SPSR_RATE           (1U << SPI2X)
+#elif (SPI_CLOCK_DIVIDER == 64U)
+#define SPI_SPCR_RATE           (1U << SPR1)
+#define SPI_SPSR_RATE           (0U)
+#elif (SPI_CLOCK_DIVIDER == 128U)
+#define SPI_SPCR_RATE           ((1U << SPR1) | (1U << SPR0))
+#define SPI_SPSR_RATE           (0U)
+#else
+#error "SPI_CLOCK_DIVIDER must be 2, 4, 8, 16, 32, 64 or 128"
+#endif
+
+#if (SPI_MODE > 3U)
+#error "SPI_MODE must be 0 to 3"
+#endif
+
+/*!< CPOL and CPHA are the bits 3 and 2 of SPCR */
+#define SPI_SPCR_MODE           ( (u8_t)(SPI_MODE << CPHA) )
+
+#if (SPI_DATA_ORDER == SPI_LSB_FIRST)
+#define SPI_SPCR_ORDER          (1U << DORD)
+#elif (SPI_DATA_ORDER == SPI_MSB_FIRST)
+#define SPI_SPCR_ORDER          (0U)
+#else
+#error "SPI_DATA_ORDER must be SPI_MSB_FIRST or SPI_LSB_FIRST"
+#endif
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PUBLIC FUNCTIONS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+ERROR_t SPI_Init(void) {
+    u8_t u8Dummy = 0;
+
+    SPCR = 0;
+
+    SPSR = SPI_SPSR_RATE;
+    SPCR = (1U << SPE) | (1U << MSTR) | SPI_SPCR_ORDER | SPI_SPCR_MODE | SPI_SPCR_RATE;
+
+    /* A flag left from before is cleared by reading SPSR, then SPDR */
+    u8Dummy = SPSR;
+    u8Dummy = SPDR;
+    (void)u8Dummy;
+
+    return ERROR_OK;
+}
+
+ERROR_t SPI_Transfer(const u8_t * const pTx, u8_t * const pRx, const u8_t length) {
+    u8_t u8Byte = 0;
+    u8_t i = 0;
+
+    if(NULL == pTx) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(BIT_IS_CLEAR(SPCR, SPE) || BIT_IS_CLEAR(SPCR, MSTR)) {
+        return ERROR_NOT_INITIALIZED;
+    }
+
+    for(i = 0; i < length; ++i) {
+        SPDR = pTx[i];
+
+        while(BIT_IS_CLEAR(SPSR, SPIF)) {
+            /* SPI_CLOCK_DIVIDER * 8 cycles */
+        }
+
+        u8Byte = SPDR;
+
+        if(NULL != pRx) {
+            pRx[i] = u8Byte;
+        }
+    }
+
+    return ERROR_OK;
+}
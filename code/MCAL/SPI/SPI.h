@@ -0,0 +1,40 @@
+/******************************************************************************
+ * @file        SPI.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref SPI.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef SPI_H
+#define SPI_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the SPI as a master, see SPI_cfg.h
+ * @pre         MOSI, SCK and SS set as outputs by DIO_Init
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t SPI_Init(void);
+
+/******************************************************************************
+ * @brief       Send bytes and receive as many at the same time
+ * @details     Returns when the last byte is shifted: SPI_CLOCK_DIVIDER * 8 
+ *              CPU cycles per byte, 16 at F_CPU / 2, less than the entry and 
+ *              exit of an interrupt. Does not touch the interrupts, so it can 
+ *              be called in a critical section.
+ * @param[in]   pTx: the bytes to send, the first one first
+ * @param[out]  pRx: the bytes received, NULL to drop them
+ * @param[in]   length: number of bytes
+ * @return      ERROR_t: ERROR_NOT_INITIALIZED before \ref SPI_Init, or after
+ *              a low level on SS made the SPI a slave. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t SPI_Transfer(const u8_t * const pTx, u8_t * const pRx, const u8_t length);
+
+
+#endif      /* SPI_H */
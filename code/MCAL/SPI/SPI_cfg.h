@@ -0,0 +1,42 @@
+/******************************************************************************
+ * @file        SPI_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref SPI.c
+ * @details     Wiring: MOSI on PB5, SCK on PB7, MISO on PB6. SS (PB4) must be
+ *              an output: as an input, a low level would turn the SPI into a 
+ *              slave. It is free for a chip select or a latch.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef SPI_CFG_H
+#define SPI_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              DO NOT CHANGE ANYTHING BELOW THIS COMMENT                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+#define SPI_MSB_FIRST           0
+#define SPI_LSB_FIRST           1
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< SCK = F_CPU / SPI_CLOCK_DIVIDER: 2, 4, 8, 16, 32, 64 or 128 */
+#define SPI_CLOCK_DIVIDER       (2U)
+
+/*!< Clock polarity and phase: 0 to 3, mode 0 samples on the rising edge of an
+     idle low clock */
+#define SPI_MODE                (0U)
+
+/*!< Options are:
+        SPI_MSB_FIRST --> bit 7 of each byte first
+        SPI_LSB_FIRST --> bit 0 of each byte first */
+#define SPI_DATA_ORDER          SPI_MSB_FIRST
+
+#endif      /* SPI_CFG_H */
@@ -0,0 +1,39 @@
+/**************************************************************************
+ * @file        SPI_reg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Serial Peripheral Interface Registers of ATmega32 MCU
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **************************************************************************/
+#ifndef SPI_REG_H
+#define SPI_REG_H
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              CHANGE THIS PART ONLY FOR NEW DEVICES                         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define SPCR       (* ((volatile u8_t *) 0x2D) )    /* SPI Control Register */
+#define SPSR       (* ((volatile u8_t *) 0x2E) )    /* SPI Status Register */
+#define SPDR       (* ((volatile u8_t *) 0x2F) )    /* SPI Data Register */
+
+enum {
+    SPR0,                                           /* SPI Clock Rate Select 0 */
+    SPR1,                                           /* SPI Clock Rate Select 1 */
+    CPHA,                                           /* Clock Phase */
+    CPOL,                                           /* Clock Polarity */
+    MSTR,                                           /* Master/Slave Select */
+    DORD,                                           /* Data Order */
+    SPE,                                            /* SPI Enable */
+    SPIE,                                           /* SPI Interrupt Enable */
+};  /* SPCR: SPI Control Register */
+
+enum {
+    SPI2X,                                          /* Double SPI Speed Bit */
+    WCOL = 6,                                       /* Write COLlision Flag */
+    SPIF,                                           /* SPI Interrupt Flag */
+};  /* SPSR: SPI Status Register */
+
+#endif      /* SPI_REG_H */
@@ -33,6 +33,58 @@ static void (*TIMER2_OVF_CBK_PTR)(void)  ;
 static void (*TIMER2_COMP_CBK_PTR)(void) ;
 
 
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              PWM SOLVER DATA                                 */
+/*                                                                              */                                
+/*------------------------------------------------------------------------------*/
+
+/*!< Prescalers of Timer 0 and Timer 1, in increasing order  */
+static const u16_t TIMER01_prescalers[] = {1, 8, 64, 256, 1024};
+
+/*!< Prescalers of Timer 2, in increasing order              */
+static const u16_t TIMER2_prescalers[]  = {1, 8, 32, 64, 128, 256, 1024};
+
+/*!< Duty cycle multiplier of each PWM channel, see \ref PWM_DUTY_SCALE */
+static u32_t PWM_dutyScale[NUM_OF_PWM_CHANNELS];
+
+/*!< Frequency error of the last solution applied to each PWM channel   */
+static s32_t PWM_errorPpm[NUM_OF_PWM_CHANNELS];
+
+
+/*------------------------------------------------------------------------------*/
+/*                                                                              */
+/*                              SYSTEM TICK DATA                                */
+/*                                                                              */                                
+/*------------------------------------------------------------------------------*/
+
+/*!< Milliseconds since TIMER_TickInit, incremented by the Timer 2 compare ISR */
+static volatile u32_t TIMER_tickMs = 0;
+
+static BOOL_t TIMER_isTickRunning = FALSE;
+
+/*!< Microseconds of one compare match: a whole part and a fraction in 
+     1/TIMER_TICK_HZ of a microsecond */
+#define TIMER_TICK_US           ( 1000000UL / TIMER_TICK_HZ )
+#define TIMER_TICK_US_FRACTION  ( 1000000UL % TIMER_TICK_HZ )
+
+/*!< Microseconds of the compare matches since TIMER_TickInit, the time base of
+     TIMER_GetTimeUs. Counted modulo 2^32, so it wraps without a jump */
+static volatile u32_t TIMER_tickUs = 0;
+
+#if (TIMER_TICK_SOURCE == TIMER_TICK_XTAL)
+/*!< Time not yet counted in TIMER_tickMs, in 1/TIMER_TICK_HZ of a millisecond */
+static u16_t TIMER_tickFraction = 0;
+
+/*!< Time not yet counted in TIMER_tickUs, in 1/TIMER_TICK_HZ of a microsecond */
+static volatile u16_t TIMER_tickUsFraction = 0;
+#endif
+
+/*!< Functions called by the tick ISR   */
+static void (*TIMER_tickCallbacks[TIMER_TICK_MAX_CALLBACKS])(void);
+static u8_t TIMER_countTickCallbacks = 0;
+
+
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
 /*                       PRIVATE FUNCTIONS DECLARATIONS                         */
@@ -48,6 +100,7 @@ static void TIMER1_ConfigMode(const TIMER_MODE_t timerMode);
 static void TIMER2_ConfigClock(const TIMER_CLOCK_t clock);
 static void TIMER2_ConfigMode(const TIMER_MODE_t timerMode);
 static void TIMER2_ConfigOC(const TIMER_MODE_t timerMode, const TIMER_OC_t compareMode);
+static void TIMER_Tick(void);
 
 /*---------------------------------------------------------------------------*/
 /*                                                                           */
@@ -55,27 +108,147 @@ static void TIMER2_ConfigOC(const TIMER_MODE_t timerMode, const TIMER_OC_t compa
 /*                                                                           */
 /*---------------------------------------------------------------------------*/
 
+void TIMER_TickInit(void) {
+    TIMER_tickMs = 0;
+    TIMER_tickUs = 0;
+
+#if (TIMER_TICK_SOURCE == TIMER_TICK_XTAL)
+    TIMER_tickFraction = 0;
+    TIMER_tickUsFraction = 0;
+
+    /* Switch the clock with the interrupts of Timer 2 off, they may fire on the
+       switch. The registers are then written through the asynchronous clock 
+       domain: each one once, a second write before its update may be lost */
+    BIT_CLR(TIMER_u8_tTIMSK_REG, OCIE2);
+    BIT_CLR(TIMER_u8_tTIMSK_REG, TOIE2);
+    BIT_SET(ASSR, AS2);
+
+    TCNT2 = 0;
+    OCR2 = (u8_t)TIMER_TICK_TOP;
+    TCCR2 = (1U << WGM21) | (u8_t)(1U << CS20);     /* CTC, the crystal not prescaled */
+
+    while( ASSR & ((1U << TCN2UB) | (1U << OCR2UB) | (1U << TCR2UB)) ) {
+        /* Wait for the update, 2 crystal cycles */
+    }
+
+    TIMER_u8_tTIFR_REG = (1U << OCF2) | (1U << TOV2);
+#else
+    TIMER2_Init(0, TIMER_TICK_CLOCK, TIMER_MODE_CTC, NO_OC);
+    TIMER2_SetCompareValue((u8_t)TIMER_TICK_TOP);
+#endif
+
+    TIMER2_EnableCompareMatchInterrupt(TIMER_Tick);
+
+    TIMER_isTickRunning = TRUE;
+}
+
+u32_t TIMER_GetTickMs(void) {
+    u32_t u32Tick = 0;
+
+    /* 32-bit read is not atomic on AVR */
+    GIE_Disable();
+    u32Tick = TIMER_tickMs;
+    GIE_Enable();
+
+    return u32Tick;
+}
+
+u32_t TIMER_GetTimeUs(void) {
+    u32_t u32Us = TIMER_tickUs;
+    u32_t u32Fraction = 0;
+    u8_t u8Count = TCNT2;
+
+#if (TIMER_TICK_SOURCE == TIMER_TICK_XTAL)
+    u32Fraction = TIMER_tickUsFraction;
+#endif
+
+    /* The counter was cleared on a match not yet counted by the ISR, the 
+       count is read again in case it was read before the clear */
+    if(BIT_IS_SET(TIMER_u8_tTIFR_REG, OCF2)) {
+        u8Count = TCNT2;
+        u32Us += TIMER_TICK_US;
+        u32Fraction += TIMER_TICK_US_FRACTION;
+        if(u32Fraction >= TIMER_TICK_HZ) {
+            u32Fraction -= TIMER_TICK_HZ;
+            u32Us++;
+        }
+    }
+
+    /* The counts and the fraction in 1/TIMER_TICK_COUNT_HZ of a second: one 
+       match is TIMER_TICK_TOP + 1 counts */
+    return u32Us + ( (((u32_t)u8Count * 1000000UL) + (u32Fraction * (TIMER_TICK_TOP + 1UL))) / TIMER_TICK_COUNT_HZ );
+}
+
+ERROR_t TIMER_TickAddCallback(void (* const callbackFunction)(void)) {
+    ERROR_t error = ERROR_OK;
+
+    if(NULL == callbackFunction) {
+        return ERROR_NULL_POINTER;
+    }
+
+    GIE_Disable();
+
+    if(TIMER_countTickCallbacks < TIMER_TICK_MAX_CALLBACKS) {
+        TIMER_tickCallbacks[TIMER_countTickCallbacks] = callbackFunction;
+        TIMER_countTickCallbacks++;
+    } else {
+        error = ERROR_OUT_OF_RANGE;
+    }
+
+    GIE_Enable();
+
+    return error;
+}
+
+ERROR_t TIMER_TickSetToggle(const BOOL_t isEnabled) {
+#if (TIMER_TICK_SOURCE == TIMER_TICK_XTAL)
+    /* The last write is still crossing to the crystal clock domain */
+    if(BIT_IS_SET(ASSR, TCR2UB)) {
+        return ERROR_BUSY;
+    }
+#endif
+
+    if(isEnabled) {
+        BIT_SET(TCCR2, COM20);
+    } else {
+        BIT_CLR(TCCR2, COM20);
+    }
+
+    return ERROR_OK;
+}
+
 ERROR_t TIMER_DelayMs(const u64_t periodInMs) {
     u32_t overflowCounter = 0;
     u32_t overflowCounterMax = 0;
+    u32_t u32Start = 0;
+
+    if(TIMER_isTickRunning) {
+        u32Start = TIMER_GetTickMs();
 
-    f64_t maxDelayInMs = ((f32_t)1 / F_CPU) * ((f32_t)TIMER0_GetTop() + 1) * 1000;
+        while( (TIMER_GetTickMs() - u32Start) < periodInMs ) {
+            /* Wait for the tick */
+        }
+
+        return ERROR_OK;
+    }
+
+    f64_t maxDelayInMs = ((f32_t)1 / F_CPU) * ((f32_t)TIMER2_GetTop() + 1) * 1000;
     overflowCounterMax = (f32_t)periodInMs / maxDelayInMs;
 
-    TIMER0_Init(0, F_CPU_CLOCK, TIMER_MODE_NORMAL, NO_OC);
+    TIMER2_Init(0, F_CPU_CLOCK, TIMER_MODE_NORMAL, NO_OC);
 
     while(overflowCounter < overflowCounterMax) {
-        while(BIT_IS_CLEAR(TIMER_u8_tTIFR_REG, TOV0)) {
+        while(BIT_IS_CLEAR(TIMER_u8_tTIFR_REG, TOV2)) {
             /* Wait for overflow */
         }
 
         /* Clear overflow flag */
-        BIT_SET(TIMER_u8_tTIFR_REG, TOV0);
+        BIT_SET(TIMER_u8_tTIFR_REG, TOV2);
 
         overflowCounter++;
     }
 
-    TIMER0_Disable();
+    TIMER2_Disable();
 
     return ERROR_OK;
 }
@@ -135,6 +308,10 @@ u8_t TIMER0_GetTimerValue(void) {
     return TCNT0;
 }
 
+BOOL_t TIMER0_IsOverflowPending(void) {
+    return BIT_IS_SET(TIMER_u8_tTIFR_REG, TOV0) ? TRUE : FALSE;
+}
+
 /*---------------------------------------------------------------------------*/
 /*                                                                           */
 /*                          PUBLIC FUNCTIONS OF TIMER1                       */
@@ -255,15 +432,72 @@ void TIMER1_DisableCaptureInterrupt(void) {
 u16_t TIMER1_GetTimerValue(void) {
     u16_t u16TimerValue = 0;
 
-    GIE_Disable();
-
     /* Lower register must be read first */
     u16TimerValue = (u16_t)TCNT1L;
     u16TimerValue |= (u16_t)(TCNT1H << 8);
 
+    return (u16TimerValue);
+}
+
+BOOL_t TIMER1_IsOverflowPending(void) {
+    return BIT_IS_SET(TIMER_u8_tTIFR_REG, TOV1) ? TRUE : FALSE;
+}
+
+void TIMER1_ConfigCapture(const TIMER_ICP_EDGE_t edge, const BOOL_t noiseCanceler) {
+    BIT_CTRL(TCCR1B, ICNC1, noiseCanceler);
+    TIMER1_SetCaptureEdge(edge);
+
+    /* Changing the edge may set the flag: drop the false capture */
+    BIT_SET(TIMER_u8_tTIFR_REG, ICF1);
+}
+
+void TIMER1_SetCaptureEdge(const TIMER_ICP_EDGE_t edge) {
+    BIT_CTRL(TCCR1B, ICES1, (TIMER_ICP_RISING == edge));
+}
+
+u16_t TIMER1_GetCaptureValue(void) {
+    u16_t u16CaptureValue = 0;
+
+    /* Lower register must be read first */
+    u16CaptureValue = (u16_t)ICR1L;
+    u16CaptureValue |= (u16_t)(ICR1H << 8);
+
+    return (u16CaptureValue);
+}
+
+void TIMER1_SetTop(const u16_t u16TopValue) {
+    GIE_Disable();
+
+    /* Upper register must be written first */
+    ICR1H = (u8_t)(u16TopValue >> 8);
+    ICR1L = (u8_t)(u16TopValue);
+
     GIE_Enable();
+}
 
-    return (u16TimerValue);
+void TIMER1_StartToggle(const u16_t u16Top, const TIMER_OCx_t OCx) {
+    u8_t u8Com = (TIMER_OCB == OCx) ? (u8_t)(1U << COM1B0) : (u8_t)(1U << COM1A0);
+    u8_t u8Foc = (TIMER_OCB == OCx) ? (u8_t)(1U << FOC1B) : (u8_t)(1U << FOC1A);
+
+    TIMER_u8_tTIMSK_REG &= (u8_t)~((1U << TICIE1) | (1U << OCIE1A) | (1U << OCIE1B) | (1U << TOIE1));
+
+    /* Stopped while the registers change */
+    TCCR1B = 0;
+
+    TCNT1H = 0;
+    TCNT1L = 0;
+    OCR1AH = (u8_t)(u16Top >> 8);
+    OCR1AL = (u8_t)u16Top;
+
+    /* OC1B matches at TOP too, so both outputs toggle with the same period */
+    OCR1BH = (u8_t)(u16Top >> 8);
+    OCR1BL = (u8_t)u16Top;
+
+    /* Toggle on compare match, forced once: the output, low since reset, is set now */
+    TCCR1A = u8Com;
+    TCCR1A = u8Com | u8Foc;
+
+    TCCR1B = (1U << WGM12) | (1U << CS12) | (1U << CS10);
 }
 
 
@@ -335,68 +569,131 @@ u8_t TIMER2_GetTimerValue(void) {
 /*                                                                           */
 /*---------------------------------------------------------------------------*/
 
-void PWM_Init(const PWM_t channel, const u32_t u32Frequency) {
-    TIMER_CLOCK_t clock;
-    u16_t prescaler = 0;
-    
-    prescaler = F_CPU / ((u32_t)256 * u32Frequency);
+ERROR_t PWM_Solve(const PWM_t channel, const u32_t u32Frequency, PWM_SOLUTION_t * const pSolution) {
+    const u16_t * prescalers = TIMER01_prescalers;
+    u8_t count = sizeof(TIMER01_prescalers) / sizeof(TIMER01_prescalers[0]);
+    u32_t u32Ticks = 0, u32Period = 0, u32BestPeriod = 0, u32Top = 0;
+    u32_t u32Error = 0, u32BestError = 0xFFFFFFFFUL;
+    u8_t i = 0;
 
-    if(prescaler / 1024) {
-        clock = F_CPU_1024;
-    }else if(prescaler / 256) {
-        clock = F_CPU_256;
-    }else if(prescaler / 64) {
-        clock = F_CPU_64;
-    }else if(prescaler / 8) {
-        clock = F_CPU_8;
-    }else{
-        clock = F_CPU_CLOCK;
+    if(NULL == pSolution) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if( (channel >= NUM_OF_PWM_CHANNELS) || (0 == u32Frequency) || (u32Frequency > F_CPU) ) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    if(PWM_3 == channel) {
+        prescalers = TIMER2_prescalers;
+        count = sizeof(TIMER2_prescalers) / sizeof(TIMER2_prescalers[0]);
+    }
+
+    /* CPU cycles in one period of the requested frequency */
+    u32Ticks = (F_CPU + (u32Frequency / 2)) / u32Frequency;
+
+    for(i = 0; i < count; ++i) {
+        if( (PWM_1 == channel) || (PWM_2 == channel) ) {
+            /* A period that does not fit in ICR1 is no candidate, unless no 
+               prescaler fits: same rule as TIMER1_PWM_PRESCALER */
+            if( (u32Ticks > (65536UL * prescalers[i])) && (i < (count - 1U)) ) {
+                continue;
+            }
+
+            /* TOP + 1 is the nearest whole number of timer ticks in a period */
+            u32Top = (u32Ticks + (prescalers[i] / 2)) / prescalers[i];
+            u32Top = (u32Top > 65536UL) ? 65535UL : ((u32Top < 4UL) ? 3UL : (u32Top - 1UL));
+        } else {
+            u32Top = 255UL;
+        }
+
+        u32Period = (u32_t)prescalers[i] * (u32Top + 1UL);
+        u32Error = (u32Period > u32Ticks) ? (u32Period - u32Ticks) : (u32Ticks - u32Period);
+
+        /* Strictly smaller only: on ties the smaller prescaler (larger TOP) wins */
+        if(u32Error < u32BestError) {
+            u32BestError = u32Error;
+            u32BestPeriod = u32Period;
+            pSolution->clock = TIMER_PRESCALER_TO_CLOCK((u32_t)prescalers[i]);
+            pSolution->top = (u16_t)u32Top;
+        }
+    }
+
+    /* Init-time only: the 64-bit division never runs in PWM_Write */
+    pSolution->dutyScale = PWM_DUTY_SCALE(pSolution->top);
+    pSolution->frequencyInHz = (F_CPU + (u32BestPeriod / 2)) / u32BestPeriod;
+    pSolution->errorPpm = (s32_t)( (((s64_t)F_CPU - ((s64_t)u32Frequency * (s64_t)u32BestPeriod)) * 1000000LL) / 
+                                   ((s64_t)u32Frequency * (s64_t)u32BestPeriod) );
+
+    return ERROR_OK;
+}
+
+ERROR_t PWM_InitSolution(const PWM_t channel, const PWM_SOLUTION_t * const pSolution) {
+    if(NULL == pSolution) {
+        return ERROR_NULL_POINTER;
     }
 
     switch(channel) {
         case PWM_0:
-            TIMER0_Init(0, clock, TIMER_MODE_FAST_PWM, CLEAR_OC);
+            TIMER0_Init(0, pSolution->clock, TIMER_MODE_FAST_PWM, CLEAR_OC);
             break;
         case PWM_1:
-            TIMER1_Init(0, clock, TIMER_MODE_FAST_PWM_8, CLEAR_OC, TIMER_OCA);
+            TIMER1_SetTop(pSolution->top);
+            TIMER1_Init(0, pSolution->clock, TIMER_MODE_FAST_PWM_ICR, CLEAR_OC, TIMER_OCA);
             break;
         case PWM_2:
-            TIMER1_Init(0, clock, TIMER_MODE_FAST_PWM_8, CLEAR_OC, TIMER_OCB);
+            TIMER1_SetTop(pSolution->top);
+            TIMER1_Init(0, pSolution->clock, TIMER_MODE_FAST_PWM_ICR, CLEAR_OC, TIMER_OCB);
             break;
         case PWM_3:
-            TIMER2_Init(0, clock, TIMER_MODE_FAST_PWM, CLEAR_OC);
+            TIMER2_Init(0, pSolution->clock, TIMER_MODE_FAST_PWM, CLEAR_OC);
             break;
-        /* TODO: implement cases for Timer 2 and 3  */
         default:
-            /* DEBUG    */
-            break;
+            return ERROR_INVALID_PARAMETER;
     }
+
+    PWM_dutyScale[channel] = pSolution->dutyScale;
+    PWM_errorPpm[channel] = pSolution->errorPpm;
+
+    return ERROR_OK;
+}
+
+ERROR_t PWM_Init(const PWM_t channel, const u32_t u32Frequency) {
+    ERROR_t error = ERROR_OK;
+    PWM_SOLUTION_t solution;
+
+    error |= PWM_Solve(channel, u32Frequency, &solution);
+
+    if(ERROR_OK == error) {
+        error |= PWM_InitSolution(channel, &solution);
+    }
+
+    return error;
 }
 
 void PWM_Write(const PWM_t channel, const u8_t u8DutyCyclePercentage) {
-    u16_t u16_tOcr = 0;
-    u16_t u16_tTop = 0;
+    u16_t u16Ocr = 0;
+
+    if(channel >= NUM_OF_PWM_CHANNELS) {
+        return;
+    }
+
+    /* OCR = duty * (TOP + 1) / 100, the division is folded into the scale */
+    u16Ocr = (u16_t)( ((u32_t)((u8DutyCyclePercentage > 100) ? 100 : u8DutyCyclePercentage) * 
+                       PWM_dutyScale[channel]) >> 16 );
 
     switch(channel) {
         case PWM_0:
-            u16_tTop = TIMER0_GetTop();
-            u16_tOcr = (u16_t)( ((u32_t)u16_tTop * u8DutyCyclePercentage) / 100 );
-            TIMER0_SetCompareValue(u16_tOcr);
+            TIMER0_SetCompareValue((u8_t)u16Ocr);
             break;
         case PWM_1:
-            u16_tTop = TIMER1_GetTop();
-            u16_tOcr = (u16_t)( ((u32_t)u16_tTop * u8DutyCyclePercentage) / 100 );
-            TIMER1_SetCompareValue(u16_tOcr, TIMER_OCA);
+            TIMER1_SetCompareValue(u16Ocr, TIMER_OCA);
             break;
         case PWM_2:
-            u16_tTop = TIMER1_GetTop();
-            u16_tOcr = (u16_t)( ((u32_t)u16_tTop * u8DutyCyclePercentage) / 100 );
-            TIMER1_SetCompareValue(u16_tOcr, TIMER_OCB);
+            TIMER1_SetCompareValue(u16Ocr, TIMER_OCB);
             break;
         case PWM_3:
-            u16_tTop = TIMER2_GetTop();
-            u16_tOcr = (u16_t)( ((u32_t)u16_tTop * u8DutyCyclePercentage) / 100 );
-            TIMER2_SetCompareValue(u16_tOcr);
+            TIMER2_SetCompareValue((u8_t)u16Ocr);
             break;
         default:
             /* DEBUG    */
@@ -404,6 +701,10 @@ void PWM_Write(const PWM_t channel, const u8_t u8DutyCyclePercentage) {
     }
 }
 
+s32_t PWM_GetFrequencyErrorPpm(const PWM_t channel) {
+    return (channel < NUM_OF_PWM_CHANNELS) ? PWM_errorPpm[channel] : 0;
+}
+
 /*---------------------------------------------------------------------------*/
 /*                                                                           */
 /*                   PRIVATE FUNCTIONS (GENERIC)                             */
@@ -827,6 +1128,34 @@ static void TIMER2_ConfigOC(const TIMER_MODE_t timerMode, const TIMER_OC_t compa
     }
 }
 
+/*!< Timer 2 compare match callback of the system tick */
+static void TIMER_Tick(void) {
+    u8_t i = 0;
+
+    TIMER_tickUs += TIMER_TICK_US;
+
+#if (TIMER_TICK_SOURCE == TIMER_TICK_XTAL)
+    TIMER_tickUsFraction += TIMER_TICK_US_FRACTION;
+    if(TIMER_tickUsFraction >= TIMER_TICK_HZ) {
+        TIMER_tickUsFraction -= TIMER_TICK_HZ;
+        TIMER_tickUs++;
+    }
+
+    /* 1024 matches per second: 24 of them are not a new millisecond */
+    TIMER_tickFraction += 1000U;
+    if(TIMER_tickFraction < TIMER_TICK_HZ) {
+        return;
+    }
+    TIMER_tickFraction -= TIMER_TICK_HZ;
+#endif
+
+    TIMER_tickMs++;
+
+    for(i = 0; i < TIMER_countTickCallbacks; ++i) {
+        TIMER_tickCallbacks[i]();
+    }
+}
+
 
 /*---------------------------------------------------------------------------*/
 /*                                                                           */
@@ -899,10 +1228,11 @@ void __vector_6(void) __attribute__((signal));
 void __vector_6(void) {
     GIE_Disable();
 
-    TIMER1_CAPT_CBK_PTR();
-
+    /* Cleared before the callback, so a capture during the callback is not lost */
     BIT_SET(TIMER_u8_tTIFR_REG, ICF1);    /*!< Clear the interrupt flag */
 
+    TIMER1_CAPT_CBK_PTR();
+
     GIE_Enable();
 }
 
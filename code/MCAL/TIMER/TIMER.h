@@ -61,13 +61,33 @@ typedef enum {
     TIMER_OCB,     /* Output Compare B */
 }TIMER_OCx_t;
 
+typedef enum {
+    TIMER_ICP_FALLING,  /* Capture TCNT1 in ICR1 on the falling edge of ICP1 */
+    TIMER_ICP_RISING    /* Capture TCNT1 in ICR1 on the rising edge of ICP1  */
+}TIMER_ICP_EDGE_t;
+
 typedef enum {
     PWM_0,    /* Connected with pin --> OC0      */
     PWM_1,    /* Connected with pin --> OC1A     */
     PWM_2,    /* Connected with pin --> OC1B     */
     PWM_3,    /* Connected with pin --> OC2      */
+    NUM_OF_PWM_CHANNELS
 }PWM_t;
 
+/*******************************************************************************
+ *  @brief      Operating point of a PWM channel found by the frequency solver
+ *  @details    Filled at run time by \ref PWM_Solve, or at compile time by the
+ *              \ref PWM_SOLUTION_TIMER0, \ref PWM_SOLUTION_TIMER1 and 
+ *              \ref PWM_SOLUTION_TIMER2 macros when the frequency is a constant.
+ ******************************************************************************/
+typedef struct {
+    TIMER_CLOCK_t   clock;          /*!< Selected prescaler                                 */
+    u16_t           top;            /*!< TOP of the counter: ICR1 on Timer 1, 255 otherwise */
+    u32_t           dutyScale;      /*!< ((TOP + 1) * 2^16) / 100: duty % to OCR multiplier */
+    u32_t           frequencyInHz;  /*!< Achieved output frequency (rounded)                */
+    s32_t           errorPpm;       /*!< (achieved - requested) / requested, in ppm         */
+}PWM_SOLUTION_t;
+
 
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
@@ -130,6 +150,12 @@ void TIMER0_DisableCompareMatchInterrupt(void);
  ******************************************************************************/
 u8_t TIMER0_GetTimerValue(void);
 
+/*******************************************************************************
+ *  @brief          Check the overflow flag of Timer 0 (TOV0)
+ *  @return         BOOL_t: TRUE if an overflow is not yet serviced
+ ******************************************************************************/
+BOOL_t TIMER0_IsOverflowPending(void);
+
 
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
@@ -206,9 +232,62 @@ void TIMER1_DisableCaptureInterrupt(void);
 
 /*******************************************************************************
  *  @brief          Get Timer 1 Value (TCNT1)
+ *  @note           Interrupts are not touched, so a caller can read TCNT1 and 
+ *                  the overflow state in the same critical section. TCNT1 is 
+ *                  read through the TEMP register of Timer 1: the caller 
+ *                  disables the interrupts if an ISR accesses a 16-bit 
+ *                  register of Timer 1
  ******************************************************************************/
 u16_t TIMER1_GetTimerValue(void);
 
+/*******************************************************************************
+ *  @brief          Check the overflow flag of Timer 1 (TOV1)
+ *  @return         BOOL_t: TRUE if an overflow is not yet serviced
+ ******************************************************************************/
+BOOL_t TIMER1_IsOverflowPending(void);
+
+/*******************************************************************************
+ *  @brief      Configure the input capture unit of Timer 1
+ *  @param[in]  edge: edge of ICP1 that captures TCNT1. See \ref TIMER_ICP_EDGE_t
+ *  @param[in]  noiseCanceler: TRUE to filter ICP1 over 4 samples (adds a
+ *              constant 4 timer clocks delay to every capture)
+ ******************************************************************************/
+void TIMER1_ConfigCapture(const TIMER_ICP_EDGE_t edge, const BOOL_t noiseCanceler);
+
+/*******************************************************************************
+ *  @brief      Select the edge of ICP1 that triggers the next capture
+ *  @param[in]  edge: See \ref TIMER_ICP_EDGE_t
+ ******************************************************************************/
+void TIMER1_SetCaptureEdge(const TIMER_ICP_EDGE_t edge);
+
+/*******************************************************************************
+ *  @brief      Get the last captured value of Timer 1 (ICR1)
+ *  @note       Interrupts are not touched, so it is meant to be called from the
+ *              capture callback where they are already disabled.
+ ******************************************************************************/
+u16_t TIMER1_GetCaptureValue(void);
+
+/*******************************************************************************
+ *  @brief      Set the TOP value of Timer 1 (ICR1). Used by the modes that take 
+ *              their TOP from ICR1, e.g. \ref TIMER_MODE_FAST_PWM_ICR
+ *  @param[in]  topValue: TOP value of the counter
+ ******************************************************************************/
+void TIMER1_SetTop(const u16_t topValue);
+
+/*******************************************************************************
+ *  @brief      Take over Timer 1 to toggle OC1A or OC1B with no software
+ *  @details    CTC mode with TOP = OCR1A, clocked by F_CPU / 1024. The output 
+ *              is set at once, then toggled every top + 1 clocks. The interrupts
+ *              of Timer 1 are disabled, the previous user of the timer stops.
+ *              Fixed register writes with no loop and no call, ~1 us: can be 
+ *              called from an ISR. The output pin must be an output
+ *  @pre        Interrupts disabled: the 16-bit registers are written through 
+ *              the TEMP register shared with the ISRs
+ *  @param[in]  top: half period of the output in F_CPU / 1024 clocks, minus 1
+ *  @param[in]  OCx: the output. See \ref TIMER_OCx_t
+ ******************************************************************************/
+void TIMER1_StartToggle(const u16_t top, const TIMER_OCx_t OCx);
+
 
 /*------------------------------------------------------------------------------*/
 /*                                                                              */
@@ -272,30 +351,269 @@ void TIMER2_DisableCompareMatchInterrupt(void);
 u8_t TIMER2_GetTimerValue(void);
 
 
+/*------------------------------------------------------------------------------*/
+/*                      Compile-time PWM frequency solver                       */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+ * @brief   CPU cycles in one PWM period of frequency \p f (rounded)
+ ******************************************************************************/
+#define PWM_TICKS(f)                ( (F_CPU + ((u32_t)(f) / 2U)) / (u32_t)(f) )
+
+/*******************************************************************************
+ * @brief   Ticks-per-period boundary above which prescaler \p nb gives a 
+ *          smaller period error than \p na on an 8-bit timer (TOP = 255)
+ ******************************************************************************/
+#define PWM_8BIT_EDGE(na, nb)       ( 128UL * ((na) + (nb)) )
+
+/*******************************************************************************
+ * @brief   Prescaler of Timer 0 giving the closest frequency to \p f
+ ******************************************************************************/
+#define TIMER0_PWM_PRESCALER(f)     ( (PWM_TICKS(f) <= PWM_8BIT_EDGE(1UL, 8UL))      ? 1UL   : \
+                                      (PWM_TICKS(f) <= PWM_8BIT_EDGE(8UL, 64UL))     ? 8UL   : \
+                                      (PWM_TICKS(f) <= PWM_8BIT_EDGE(64UL, 256UL))   ? 64UL  : \
+                                      (PWM_TICKS(f) <= PWM_8BIT_EDGE(256UL, 1024UL)) ? 256UL : 1024UL )
+
+/*******************************************************************************
+ * @brief   Prescaler of Timer 2 giving the closest frequency to \p f. Timer 2
+ *          is the only one with the /32 and /128 prescalers.
+ ******************************************************************************/
+#define TIMER2_PWM_PRESCALER(f)     ( (PWM_TICKS(f) <= PWM_8BIT_EDGE(1UL, 8UL))      ? 1UL   : \
+                                      (PWM_TICKS(f) <= PWM_8BIT_EDGE(8UL, 32UL))     ? 8UL   : \
+                                      (PWM_TICKS(f) <= PWM_8BIT_EDGE(32UL, 64UL))    ? 32UL  : \
+                                      (PWM_TICKS(f) <= PWM_8BIT_EDGE(64UL, 128UL))   ? 64UL  : \
+                                      (PWM_TICKS(f) <= PWM_8BIT_EDGE(128UL, 256UL))  ? 128UL : \
+                                      (PWM_TICKS(f) <= PWM_8BIT_EDGE(256UL, 1024UL)) ? 256UL : 1024UL )
+
+/*******************************************************************************
+ * @brief   Smallest prescaler of Timer 1 that fits one period of \p f in the 
+ *          16-bit ICR1, which gives the best duty cycle resolution. Each 
+ *          prescaler divides the next one, so it is also the closest 
+ *          frequency: \ref PWM_Solve picks the same one
+ ******************************************************************************/
+#define TIMER1_PWM_PRESCALER(f)     ( (PWM_TICKS(f) <= 65536UL)    ? 1UL   : \
+                                      (PWM_TICKS(f) <= 524288UL)   ? 8UL   : \
+                                      (PWM_TICKS(f) <= 4194304UL)  ? 64UL  : \
+                                      (PWM_TICKS(f) <= 16777216UL) ? 256UL : 1024UL )
+
+/*******************************************************************************
+ * @brief   ICR1 value of Timer 1 for frequency \p f and prescaler \p n, 
+ *          clamped to the 2-bit minimum and the 16-bit maximum resolution
+ ******************************************************************************/
+#define TIMER1_PWM_TOP(f, n)        ( (((PWM_TICKS(f) + ((n) / 2U)) / (n)) > 65536UL) ? 65535UL :  \
+                                      (((PWM_TICKS(f) + ((n) / 2U)) / (n)) < 4UL)     ? 3UL     :  \
+                                      (((PWM_TICKS(f) + ((n) / 2U)) / (n)) - 1UL) )
+
+/*******************************************************************************
+ * @brief   Map a prescaler division factor to \ref TIMER_CLOCK_t
+ ******************************************************************************/
+#define TIMER_PRESCALER_TO_CLOCK(n) ( ((n) == 1UL)   ? F_CPU_CLOCK : ((n) == 8UL)   ? F_CPU_8   : \
+                                      ((n) == 32UL)  ? F_CPU_32    : ((n) == 64UL)  ? F_CPU_64  : \
+                                      ((n) == 128UL) ? F_CPU_128   : ((n) == 256UL) ? F_CPU_256 : F_CPU_1024 )
+
+/*******************************************************************************
+ * @brief   Duty cycle multiplier: OCR = (duty% * scale) >> 16
+ ******************************************************************************/
+#define PWM_DUTY_SCALE(top)         ( (((u32_t)(top) + 1UL) << 16) / 100UL )
+
+/*******************************************************************************
+ * @brief   Achieved frequency error in ppm for prescaler \p n and TOP \p top
+ ******************************************************************************/
+#define PWM_ERROR_PPM(f, n, top)    ( (s32_t)( (((s64_t)F_CPU - ((s64_t)(f) * (s64_t)(n) * ((s64_t)(top) + 1))) * 1000000LL) / \
+                                               ((s64_t)(f) * (s64_t)(n) * ((s64_t)(top) + 1)) ) )
+
+#define PWM_ROUND_DIV(a, b)         ( ((a) + ((b) / 2UL)) / (b) )
+
+#define PWM_SOLUTION_8BIT(f, n)     { TIMER_PRESCALER_TO_CLOCK(n), 255U, PWM_DUTY_SCALE(255U),      \
+                                      ((F_CPU + ((n) * 128UL)) / ((n) * 256UL)), PWM_ERROR_PPM(f, n, 255UL) }
+
+/*******************************************************************************
+ * @brief   Initializers of \ref PWM_SOLUTION_t computed by the compiler. Use 
+ *          them instead of \ref PWM_Init when the frequency is a constant, so
+ *          no division is done at run time.
+ * @par     Example:
+ *          @code
+ *          static const PWM_SOLUTION_t dimmer = PWM_SOLUTION_TIMER1(500);
+ *          PWM_InitSolution(PWM_1, &dimmer);   // 500 Hz exactly, ICR1 = 3999
+ *          @endcode
+ ******************************************************************************/
+#define PWM_SOLUTION_TIMER0(f)      PWM_SOLUTION_8BIT(f, TIMER0_PWM_PRESCALER(f))
+#define PWM_SOLUTION_TIMER2(f)      PWM_SOLUTION_8BIT(f, TIMER2_PWM_PRESCALER(f))
+#define PWM_SOLUTION_TIMER1(f)      { TIMER_PRESCALER_TO_CLOCK(TIMER1_PWM_PRESCALER(f)),                    \
+                                      TIMER1_PWM_TOP(f, TIMER1_PWM_PRESCALER(f)),                           \
+                                      PWM_DUTY_SCALE(TIMER1_PWM_TOP(f, TIMER1_PWM_PRESCALER(f))),           \
+                                      PWM_ROUND_DIV(F_CPU, TIMER1_PWM_PRESCALER(f) *                        \
+                                                    (TIMER1_PWM_TOP(f, TIMER1_PWM_PRESCALER(f)) + 1UL)),    \
+                                      PWM_ERROR_PPM(f, TIMER1_PWM_PRESCALER(f),                             \
+                                                    TIMER1_PWM_TOP(f, TIMER1_PWM_PRESCALER(f))) }
+
+
 /*------------------------------------------------------------------------------*/
 /*                      Prototypes of PWMs functions                            */
 /*------------------------------------------------------------------------------*/
 
+/*******************************************************************************
+ *  @brief      Find the prescaler and TOP giving the closest frequency to the
+ *              requested one on the timer of a PWM channel
+ *  @details    Every prescaler of the timer is tried. Timer 1 runs in 
+ *              \ref TIMER_MODE_FAST_PWM_ICR, so ICR1 is solved too: only the
+ *              prescalers fitting one period in ICR1 are tried. Each prescaler
+ *              divides the next one, so the smallest of them also gives the 
+ *              smallest error and the finest duty cycle, the prescaler of 
+ *              \ref TIMER1_PWM_PRESCALER. Timers 0 and 2
+ *              have a fixed TOP of 255 in fast PWM, so only the prescaler is
+ *              chosen (Timer 2 also has /32 and /128).
+ *  @param[in]  channel: PWM channel. See \ref PWM_t
+ *  @param[in]  frequencyInHz: requested frequency of the PWM signal
+ *  @param[out] pSolution: the solved operating point and its frequency error
+ *  @return     ERROR_t: ERROR_OK, ERROR_NULL_POINTER or ERROR_INVALID_PARAMETER
+ ******************************************************************************/
+ERROR_t PWM_Solve(const PWM_t channel, const u32_t frequencyInHz, PWM_SOLUTION_t * const pSolution);
+
+/*******************************************************************************
+ *  @brief      Configure a PWM channel from an already solved operating point
+ *  @param[in]  channel: PWM channel. See \ref PWM_t
+ *  @param[in]  pSolution: operating point from \ref PWM_Solve or one of the
+ *              PWM_SOLUTION_TIMERx macros
+ *  @return     ERROR_t: ERROR_OK, ERROR_NULL_POINTER or ERROR_INVALID_PARAMETER
+ *  @note       PWM_1 and PWM_2 share ICR1, so they share the same frequency.
+ ******************************************************************************/
+ERROR_t PWM_InitSolution(const PWM_t channel, const PWM_SOLUTION_t * const pSolution);
+
 /*******************************************************************************
  *  @brief          Initialize PWM
  *  @param[in]  channel: PWM channel, can be one of the following:
- *              \ref PWM_0 to \ref PWM_7. Members of \ref PWM_t enumeration
- * @param[in]   frequencyInKHz: frequency of the PWM signal
+ *              \ref PWM_0 to \ref PWM_3. Members of \ref PWM_t enumeration
+ * @param[in]   frequencyInHz: frequency of the PWM signal
+ * @return      ERROR_t: error code. See \ref ERROR_t
  ******************************************************************************/
-void PWM_Init(const PWM_t channel, const u32_t frequencyInKHz);
+ERROR_t PWM_Init(const PWM_t channel, const u32_t frequencyInHz);
 
 /*******************************************************************************
  *  @brief          Set Duty Cycle of PWM
+ *  @details    The OCR value is a multiply by the scale solved at init time, 
+ *              no division is done.
  *  @param[in]  channel: PWM channel, can be one of the following:
- *              \ref PWM_0 to \ref PWM_7. Members of \ref PWM_t enumeration
- * @param[in]   dutyCyclePercentage: duty cycle of the PWM signal in %
+ *              \ref PWM_0 to \ref PWM_3. Members of \ref PWM_t enumeration
+ * @param[in]   dutyCyclePercentage: duty cycle of the PWM signal in % (0-100)
  ******************************************************************************/
 void PWM_Write(const PWM_t channel, const u8_t dutyCyclePercentage);
 
+/*******************************************************************************
+ *  @brief      Get the frequency error of the last solution applied to a channel
+ *  @param[in]  channel: PWM channel. See \ref PWM_t
+ *  @return     s32_t: (achieved - requested) / requested, in ppm
+ ******************************************************************************/
+s32_t PWM_GetFrequencyErrorPpm(const PWM_t channel);
+
 
 /*------------------------------------------------------------------------------*/
 /*                      Prototypes of delay functions                           */
 /*------------------------------------------------------------------------------*/
+
+/*!< Options of TIMER_TICK_SOURCE */
+#define TIMER_TICK_CPU          0
+#define TIMER_TICK_XTAL         1
+
+/*!< Clock of the system tick, Timer 2 in CTC mode:
+     TIMER_TICK_XTAL: the 32.768 kHz crystal on TOSC1/TOSC2 (PC6/PC7), Timer 2 
+                      in asynchronous mode. The tick keeps the time of the 
+                      crystal, and keeps running in power-save sleep
+     TIMER_TICK_CPU:  the CPU clock */
+#define TIMER_TICK_SOURCE       TIMER_TICK_XTAL
+
+#if (TIMER_TICK_SOURCE == TIMER_TICK_XTAL)
+
+/*!< 1024 compare matches per second, 1000 of them count a millisecond */
+#define TIMER_TICK_XTAL_HZ      32768UL
+#define TIMER_TICK_PRESCALER    1UL
+#define TIMER_TICK_HZ           1024UL
+#define TIMER_TICK_COUNT_HZ     ( TIMER_TICK_XTAL_HZ / TIMER_TICK_PRESCALER )
+#define TIMER_TICK_TOP          ( (TIMER_TICK_COUNT_HZ / TIMER_TICK_HZ) - 1UL )
+
+#elif (TIMER_TICK_SOURCE == TIMER_TICK_CPU)
+
+/*!< One compare match every millisecond */
+#define TIMER_TICK_CLOCK        F_CPU_64
+#define TIMER_TICK_PRESCALER    64UL
+#define TIMER_TICK_HZ           1000UL
+#define TIMER_TICK_COUNT_HZ     ( F_CPU / TIMER_TICK_PRESCALER )
+#define TIMER_TICK_TOP          ( (TIMER_TICK_COUNT_HZ / TIMER_TICK_HZ) - 1UL )
+
+#if (TIMER_TICK_TOP > 255UL) || ((TIMER_TICK_TOP + 1UL) * TIMER_TICK_PRESCALER * TIMER_TICK_HZ != F_CPU)
+#error "F_CPU does not give an exact 1 ms tick, update TIMER_TICK_CLOCK and TIMER_TICK_PRESCALER"
+#endif
+
+#else
+#error "TIMER_TICK_SOURCE is not defined"
+#endif
+
+/*!< Functions that can be called from the tick ISR, see \ref TIMER_TickAddCallback */
+#define TIMER_TICK_MAX_CALLBACKS    (6U)
+
+/*******************************************************************************
+ *  @brief      Start the millisecond system tick on Timer 2
+ *  @details    Timer 2 is owned by the tick from now on, it can no more be used
+ *              for PWM_3. In asynchronous mode, the first ticks come once the 
+ *              crystal has started, up to one second later.
+ ******************************************************************************/
+void TIMER_TickInit(void);
+
+/*******************************************************************************
+ *  @brief      Get the milliseconds elapsed since \ref TIMER_TickInit
+ *  @details    Wraps after ~49 days, elapsed times must be computed as an 
+ *              unsigned difference: (TIMER_GetTickMs() - start) >= period.
+ *              Toggles the global interrupt, not to be called from an ISR.
+ *  @return     u32_t: the tick counter
+ ******************************************************************************/
+u32_t TIMER_GetTickMs(void);
+
+/*******************************************************************************
+ *  @brief      Get the microseconds elapsed since \ref TIMER_TickInit
+ *  @details    Resolution of one count of Timer 2: 30.5 us with TIMER_TICK_XTAL,
+ *              4 us with TIMER_TICK_CPU. Wraps after ~71 minutes without a 
+ *              jump, elapsed times must be computed as an unsigned difference.
+ *  @note       Interrupts must be disabled, so it is meant to be called from a
+ *              callback, or between GIE_Disable and GIE_Enable.
+ *  @return     u32_t: the time in us
+ ******************************************************************************/
+u32_t TIMER_GetTimeUs(void);
+
+/*******************************************************************************
+ *  @brief      Call a function every millisecond from the tick ISR
+ *  @details    The callbacks run in interrupt context, in the order they were 
+ *              added, and must return within a small part of the millisecond.
+ *              With TIMER_TICK_XTAL, they are called 1000 times per second of
+ *              the crystal, but 1 to 2 compare matches (0.98 to 1.95 ms) apart.
+ *  @param[in]  callbackFunction: the function to call
+ *  @return     ERROR_t: ERROR_OUT_OF_RANGE if TIMER_TICK_MAX_CALLBACKS are 
+ *              already added. See \ref ERROR_t
+ ******************************************************************************/
+ERROR_t TIMER_TickAddCallback(void (* const callbackFunction)(void));
+
+/*******************************************************************************
+ *  @brief      Toggle OC2 on each compare match of the tick
+ *  @details    A square wave of TIMER_TICK_HZ / 2 made by the hardware on OC2
+ *              (PD7), e.g. to drive a piezo: no CPU time while it runs. When 
+ *              disabled, the pin takes the level of its PORT bit. With 
+ *              TIMER_TICK_XTAL, TCCR2 is written through the asynchronous 
+ *              clock domain, in 2 crystal cycles (61 us).
+ *  @pre        \ref TIMER_TickInit, OC2 set as an output. Called from a tick
+ *              callback, or with the interrupts disabled: TCCR2 is read, 
+ *              modified and written
+ *  @param[in]  isEnabled: TRUE to start the toggling, FALSE to stop it
+ *  @return     ERROR_t: ERROR_BUSY if the previous write is not taken yet, 
+ *              the call is to be retried. See \ref ERROR_t
+ ******************************************************************************/
+ERROR_t TIMER_TickSetToggle(const BOOL_t isEnabled);
+
+/*******************************************************************************
+ *  @brief      Busy wait for a period of time
+ *  @details    Waits on the system tick when it runs, otherwise polls the 
+ *              overflow flag of Timer 2. Timer 0 and Timer 1 are left free to 
+ *              count external pulses on T0/T1.
+ *  @param[in]  periodInMs: period to wait in milliseconds
+ ******************************************************************************/
 ERROR_t TIMER_DelayMs(const u64_t periodInMs);
 
 
@@ -85,6 +85,15 @@ enum {
     FOC2,    /* Force Output Compare Bit */
 };  /* TCCR2: Timer/Counter 2 Control Register */
 
+#define ASSR       (* ((volatile u8_t *) 0x42) )
+
+enum {
+    TCR2UB,  /* Timer/Counter Control Register 2 Update Busy */
+    OCR2UB,  /* Output Compare Register 2 Update Busy */
+    TCN2UB,  /* Timer/Counter 2 Update Busy */
+    AS2,     /* Asynchronous Timer/Counter 2: clocked from TOSC1 */
+};  /* ASSR: Asynchronous Status Register */
+
 /**************************************************************************
  *                     Timers/Counters Common Registers
  **************************************************************************/
@@ -0,0 +1,260 @@
+/**************************************************************************
+ * @file        TWI.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       TWI (I2C) master driver for Atmega32 microcontroller.
+ * @details     The transactions wait in a ring of pointers with one writer 
+ *              and one reader: the head is only written by the application 
+ *              and the tail by the ISR, the indexes are single bytes, so the 
+ *              ring needs no lock. The TWI interrupt moves the transaction 
+ *              at the tail by one step per byte, then starts the next one.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ***************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+
+#include "../GIE/GIE.h"
+
+#include "TWI_reg.h"
+#include "TWI.h"
+#include "TWI_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                            PRIVATE FUNCTIONS PROTOTYPES                    */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+static void TWI_Finish(TWI_TRANSACTION_t * const pTransaction, const ERROR_t result);
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                            MACRO LIKE FUNCTIONS                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define TWI_QUEUE_MASK              ( TWI_QUEUE_SIZE - 1U )
+
+#if (TWI_QUEUE_SIZE & TWI_QUEUE_MASK) || (TWI_QUEUE_SIZE > 128U)
+#error "TWI_QUEUE_SIZE must be a power of 2, up to 128"
+#endif
+
+/*!< Bit rate divider with a prescaler of 1 */
+#define TWI_TWBR                    ( ((F_CPU / TWI_SCL_HZ) - 16UL) / 2UL )
+
+#if (TWI_TWBR > 255UL)
+#error "TWI_SCL_HZ is too low for F_CPU"
+#endif
+
+/*!< The master needs at least 10, see the data sheet */
+#if (TWI_TWBR < 10UL)
+#error "TWI_SCL_HZ is too high for F_CPU"
+#endif
+
+/*!< TWCR to go on with the bus: clear the flag, keep the TWI and its interrupt */
+#define TWI_CONTROL                 ( (1U << TWINT) | (1U << TWEN) | (1U << TWIE) )
+
+/*!< Read bit of the address byte */
+#define TWI_READ                    (1U)
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                           PRIVATE GLOBALS VARIABLES                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Queue: head written by the application, tail by the ISR */
+static TWI_TRANSACTION_t * volatile TWI_queue[TWI_QUEUE_SIZE];
+static volatile u8_t TWI_head = 0;
+static volatile u8_t TWI_tail = 0;
+
+/*!< The ISR works on the transaction at the tail, FALSE once the bus is released */
+static volatile BOOL_t TWI_isBusy = FALSE;
+
+/*!< Next byte to write or to read of the transaction at the tail */
+static volatile u8_t TWI_index = 0;
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PUBLIC FUNCTIONS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+ERROR_t TWI_Init(void) {
+    GIE_Disable();
+
+    TWCR = 0;
+
+    TWI_head = 0;
+    TWI_tail = 0;
+    TWI_isBusy = FALSE;
+
+    TWSR = 0;
+    TWBR = (u8_t)TWI_TWBR;
+
+    /* The TWI takes SCL and SDA from the DIO */
+    TWCR = (1U << TWEN) | (1U << TWIE);
+
+    GIE_Enable();
+
+    return ERROR_OK;
+}
+
+ERROR_t TWI_Submit(TWI_TRANSACTION_t * const pTransaction) {
+    u8_t u8Head = TWI_head;
+    u8_t u8Next = (u8_t)(u8Head + 1U) & TWI_QUEUE_MASK;
+
+    if(NULL == pTransaction) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if( ((0 != pTransaction->writeLength) && (NULL == pTransaction->pWrite)) ||
+        ((0 != pTransaction->readLength) && (NULL == pTransaction->pRead)) ) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(pTransaction->address > 0x7FU) {
+        return ERROR_INVALID_PARAMETER;
+    }
+
+    if( (ERROR_BUSY == pTransaction->result) || (u8Next == TWI_tail) ) {
+        return ERROR_BUSY;
+    }
+
+    pTransaction->result = ERROR_BUSY;
+    TWI_queue[u8Head] = pTransaction;
+
+    /* Publish the transaction, then wake the bus if the ISR is done */
+    GIE_Disable();
+    TWI_head = u8Next;
+
+    if(FALSE == TWI_isBusy) {
+        TWI_isBusy = TRUE;
+
+        /* A STOP still on the bus is kept, the START follows it */
+        TWCR = (TWCR & (1U << TWSTO)) | TWI_CONTROL | (1U << TWSTA);
+    }
+    GIE_Enable();
+
+    return ERROR_OK;
+}
+
+BOOL_t TWI_IsIdle(void) {
+    return (FALSE == TWI_isBusy) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                              PRIVATE FUNCTIONS                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   End the transaction at the tail
+ * @details Called from the ISR. The STOP is sent, followed by the START of the
+ *          next transaction if any, before the callback: the bus goes on 
+ *          while it runs. The callback may submit a new transaction.
+ * @param   pTransaction: the transaction at the tail
+ * @param   result: its result
+ ******************************************************************************/
+static void TWI_Finish(TWI_TRANSACTION_t * const pTransaction, const ERROR_t result) {
+    u8_t u8Tail = (u8_t)(TWI_tail + 1U) & TWI_QUEUE_MASK;
+
+    TWI_tail = u8Tail;
+
+    if(u8Tail != TWI_head) {
+        TWCR = TWI_CONTROL | (1U << TWSTO) | (1U << TWSTA);
+    } else {
+        TWCR = TWI_CONTROL | (1U << TWSTO);
+        TWI_isBusy = FALSE;
+    }
+
+    pTransaction->result = result;
+
+    if(NULL != pTransaction->callback) {
+        pTransaction->callback();
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                              ISR FUNCTIONS                                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/* ISR of TWI */
+void __vector_19(void) __attribute__((signal));
+void __vector_19(void) {
+    TWI_TRANSACTION_t * const pTransaction = TWI_queue[TWI_tail];
+    u8_t u8Status = TWSR & TWI_STATUS_MASK;
+    u8_t u8Index = TWI_index;
+
+    GIE_Disable();
+
+    switch(u8Status) {
+        case TWI_STATUS_START:
+        case TWI_STATUS_REP_START:
+            TWI_index = 0;
+
+            /* The read follows the write after a repeated START */
+            if( (TWI_STATUS_REP_START == u8Status) || 
+                ((0 == pTransaction->writeLength) && (0 != pTransaction->readLength)) ) {
+                TWDR = (u8_t)(pTransaction->address << 1) | TWI_READ;
+            } else {
+                TWDR = (u8_t)(pTransaction->address << 1);
+            }
+
+            TWCR = TWI_CONTROL;
+            break;
+
+        case TWI_STATUS_SLA_W_ACK:
+        case TWI_STATUS_DATA_W_ACK:
+            if(u8Index < pTransaction->writeLength) {
+                TWDR = pTransaction->pWrite[u8Index];
+                TWI_index = u8Index + 1U;
+                TWCR = TWI_CONTROL;
+            } else if(0 != pTransaction->readLength) {
+                TWCR = TWI_CONTROL | (1U << TWSTA);
+            } else {
+                TWI_Finish(pTransaction, ERROR_OK);
+            }
+            break;
+
+        case TWI_STATUS_SLA_R_ACK:
+            /* The last byte is not acknowledged, it ends the read */
+            if(pTransaction->readLength > 1U) {
+                TWCR = TWI_CONTROL | (1U << TWEA);
+            } else {
+                TWCR = TWI_CONTROL;
+            }
+            break;
+
+        case TWI_STATUS_DATA_R_ACK:
+            pTransaction->pRead[u8Index] = TWDR;
+            ++u8Index;
+            TWI_index = u8Index;
+
+            if((u8_t)(u8Index + 1U) < pTransaction->readLength) {
+                TWCR = TWI_CONTROL | (1U << TWEA);
+            } else {
+                TWCR = TWI_CONTROL;
+            }
+            break;
+
+        case TWI_STATUS_DATA_R_NACK:
+            pTransaction->pRead[u8Index] = TWDR;
+            TWI_Finish(pTransaction, ERROR_OK);
+            break;
+
+        case TWI_STATUS_ARB_LOST:
+            /* Another master took the bus: start again once it is free */
+            TWCR = TWI_CONTROL | (1U << TWSTA);
+            break;
+
+        default:
+            /* Not acknowledged, or a bus error: the STOP releases the bus */
+            TWI_Finish(pTransaction, ERROR_NOK);
+            break;
+    }
+
+    GIE_Enable();
+}
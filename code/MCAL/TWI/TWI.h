@@ -0,0 +1,75 @@
+/******************************************************************************
+ * @file        TWI.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref TWI.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef TWI_H
+#define TWI_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   A transaction with one chip: the bytes written, then the bytes 
+ *          read after a repeated START
+ * @details - address:      7 bits address of the chip
+ *          - pWrite:       bytes to write, e.g. the register of the chip
+ *          - writeLength:  their number, 0 for a read only
+ *          - pRead:        where to store the bytes read
+ *          - readLength:   their number, 0 for a write only
+ *          - callback:     called from the ISR at the end, NULL for none
+ *          - result:       ERROR_BUSY while queued, then ERROR_OK, or 
+ *                          ERROR_NOK if the chip did not acknowledge
+ *          The transaction and its buffers are owned by the driver until the 
+ *          result is no more ERROR_BUSY.
+ ******************************************************************************/
+typedef struct {
+    u8_t            address;
+    const u8_t *    pWrite;
+    u8_t            writeLength;
+    u8_t *          pRead;
+    u8_t            readLength;
+    void         (* callback)(void);
+    volatile ERROR_t result;
+}TWI_TRANSACTION_t;
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the TWI as the single master of the bus, see TWI_cfg.h
+ * @details     The transfers are driven by the TWI interrupt, one byte per 
+ *              interrupt: the application never waits for the bus.
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t TWI_Init(void);
+
+/******************************************************************************
+ * @brief       Queue a transaction
+ * @details     Never blocks. The transactions are done in their order, with 
+ *              a STOP between two of them. The bus is started at once when 
+ *              it is idle.
+ * @param[in]   pTransaction: the transaction, see \ref TWI_TRANSACTION_t
+ * @return      ERROR_t: ERROR_BUSY if the queue is full or the transaction is
+ *              already queued. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t TWI_Submit(TWI_TRANSACTION_t * const pTransaction);
+
+/******************************************************************************
+ * @brief       Check if the queue is empty and the bus released
+ * @return      BOOL_t: TRUE if idle
+ *****************************************************************************/
+BOOL_t TWI_IsIdle(void);
+
+
+#endif      /* TWI_H */
@@ -0,0 +1,27 @@
+/******************************************************************************
+ * @file        TWI_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref TWI.c
+ * @details     Wiring: SCL on PC0, SDA on PC1, each pulled up to VCC by an
+ *              external resistor (4.7k at 100 kHz, 2.2k at 400 kHz).
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef TWI_CFG_H
+#define TWI_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< SCL frequency: 100 kHz standard mode, or 400 kHz fast mode when all the 
+     chips on the bus support it */
+#define TWI_SCL_HZ              (100000UL)
+
+/*!< Transactions waiting for the bus, a power of 2. One entry stays unused */
+#define TWI_QUEUE_SIZE          (8U)
+
+#endif      /* TWI_CFG_H */
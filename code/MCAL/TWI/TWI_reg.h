@@ -0,0 +1,57 @@
+/**************************************************************************
+ * @file        TWI_reg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Two-wire Serial Interface Registers of ATmega32 MCU
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **************************************************************************/
+#ifndef TWI_REG_H
+#define TWI_REG_H
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              CHANGE THIS PART ONLY FOR NEW DEVICES                         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define TWBR       (* ((volatile u8_t *) 0x20) )    /* TWI Bit Rate Register */
+#define TWSR       (* ((volatile u8_t *) 0x21) )    /* TWI Status Register */
+#define TWAR       (* ((volatile u8_t *) 0x22) )    /* TWI (Slave) Address Register */
+#define TWDR       (* ((volatile u8_t *) 0x23) )    /* TWI Data Register */
+#define TWCR       (* ((volatile u8_t *) 0x56) )    /* TWI Control Register */
+
+enum {
+    TWIE,                                           /* TWI Interrupt Enable */
+    TWCR_RESERVED,
+    TWEN,                                           /* TWI Enable */
+    TWWC,                                           /* TWI Write Collision Flag */
+    TWSTO,                                          /* TWI STOP Condition */
+    TWSTA,                                          /* TWI START Condition */
+    TWEA,                                           /* TWI Enable Acknowledge */
+    TWINT,                                          /* TWI Interrupt Flag */
+};  /* TWCR: TWI Control Register */
+
+enum {
+    TWPS0,                                          /* TWI Prescaler Bit 0 */
+    TWPS1,                                          /* TWI Prescaler Bit 1 */
+};  /* TWSR: TWI Status Register, the status in bits 3 to 7 */
+
+/*!< Bits of the status in TWSR */
+#define TWI_STATUS_MASK             (0xF8U)
+
+/*!< Status codes of the master modes */
+#define TWI_STATUS_START            (0x08U)     /* START transmitted */
+#define TWI_STATUS_REP_START        (0x10U)     /* Repeated START transmitted */
+#define TWI_STATUS_SLA_W_ACK        (0x18U)     /* SLA+W transmitted, ACK received */
+#define TWI_STATUS_SLA_W_NACK       (0x20U)     /* SLA+W transmitted, NOT ACK received */
+#define TWI_STATUS_DATA_W_ACK       (0x28U)     /* Data transmitted, ACK received */
+#define TWI_STATUS_DATA_W_NACK      (0x30U)     /* Data transmitted, NOT ACK received */
+#define TWI_STATUS_ARB_LOST         (0x38U)     /* Arbitration lost */
+#define TWI_STATUS_SLA_R_ACK        (0x40U)     /* SLA+R transmitted, ACK received */
+#define TWI_STATUS_SLA_R_NACK       (0x48U)     /* SLA+R transmitted, NOT ACK received */
+#define TWI_STATUS_DATA_R_ACK       (0x50U)     /* Data received, ACK returned */
+#define TWI_STATUS_DATA_R_NACK      (0x58U)     /* Data received, NOT ACK returned */
+#define TWI_STATUS_BUS_ERROR        (0x00U)     /* Illegal START or STOP */
+
+#endif      /* TWI_REG_H */
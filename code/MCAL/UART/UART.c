@@ -0,0 +1,193 @@
+/**************************************************************************
+ * @file        UART.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       USART driver for Atmega32 microcontroller.
+ * @details     Asynchronous, 8N1. Each direction has a ring buffer with one
+ *              writer and one reader: the index written by the ISR is only
+ *              read by the application and the other way round, and the 
+ *              indexes are single bytes, so the rings need no lock.
+ *              The data register empty interrupt is enabled while the 
+ *              transmit ring holds bytes.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ***************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+
+#include "../GIE/GIE.h"
+
+#include "UART_reg.h"
+#include "UART.h"
+#include "UART_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                            MACRO LIKE FUNCTIONS                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define UART_RX_BUFFER_MASK         ( UART_RX_BUFFER_SIZE - 1U )
+#define UART_TX_BUFFER_MASK         ( UART_TX_BUFFER_SIZE - 1U )
+
+#if (UART_RX_BUFFER_SIZE & UART_RX_BUFFER_MASK) || (UART_RX_BUFFER_SIZE > 128U)
+#error "UART_RX_BUFFER_SIZE must be a power of 2, up to 128"
+#endif
+
+#if (UART_TX_BUFFER_SIZE & UART_TX_BUFFER_MASK) || (UART_TX_BUFFER_SIZE > 128U)
+#error "UART_TX_BUFFER_SIZE must be a power of 2, up to 128"
+#endif
+
+/*!< Nearest divider of the normal speed mode */
+#define UART_UBRR                   ( ((F_CPU + (8UL * UART_BAUD_RATE)) / (16UL * UART_BAUD_RATE)) - 1UL )
+#define UART_ACTUAL_BAUD_RATE       ( F_CPU / (16UL * (UART_UBRR + 1UL)) )
+
+#if (UART_UBRR > 4095UL)
+#error "UART_BAUD_RATE is too low for F_CPU"
+#endif
+
+/*!< The receiver tolerates about 2% of error, shared by both ends */
+#if ( ((UART_ACTUAL_BAUD_RATE * 100UL) > (UART_BAUD_RATE * 101UL)) || \
+      ((UART_ACTUAL_BAUD_RATE * 100UL) < (UART_BAUD_RATE * 99UL)) )
+#error "UART_BAUD_RATE can not be reached within 1% with F_CPU"
+#endif
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                           PRIVATE GLOBALS VARIABLES                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Receive ring: head written by the ISR, tail by the application */
+static volatile u8_t UART_rxBuffer[UART_RX_BUFFER_SIZE];
+static volatile u8_t UART_rxHead = 0;
+static volatile u8_t UART_rxTail = 0;
+
+/*!< Transmit ring: head written by the application, tail by the ISR */
+static volatile u8_t UART_txBuffer[UART_TX_BUFFER_SIZE];
+static volatile u8_t UART_txHead = 0;
+static volatile u8_t UART_txTail = 0;
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PUBLIC FUNCTIONS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+ERROR_t UART_Init(void) {
+    GIE_Disable();
+
+    UCSRB = 0;
+
+    UART_rxHead = 0;
+    UART_rxTail = 0;
+    UART_txHead = 0;
+    UART_txTail = 0;
+
+    /* UBRRH shares its address with UCSRC, URSEL selects the register */
+    UBRRH = (u8_t)(UART_UBRR >> 8) & (u8_t)~(1U << URSEL);
+    UBRRL = (u8_t)UART_UBRR;
+
+    UCSRA = 0;
+    UCSRC = (1U << URSEL) | (1U << UCSZ1) | (1U << UCSZ0);
+
+    UCSRB = (1U << RXCIE) | (1U << RXEN) | (1U << TXEN);
+
+    GIE_Enable();
+
+    return ERROR_OK;
+}
+
+ERROR_t UART_Receive(u8_t * const pByte) {
+    u8_t u8Tail = UART_rxTail;
+
+    if(NULL == pByte) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(u8Tail == UART_rxHead) {
+        return ERROR_NOK;
+    }
+
+    *pByte = UART_rxBuffer[u8Tail];
+    UART_rxTail = (u8_t)(u8Tail + 1U) & UART_RX_BUFFER_MASK;
+
+    return ERROR_OK;
+}
+
+ERROR_t UART_Send(const u8_t * const pData, const u8_t length) {
+    u8_t u8Head = UART_txHead;
+    u8_t i = 0;
+
+    if(NULL == pData) {
+        return ERROR_NULL_POINTER;
+    }
+
+    if(length > UART_GetTxSpace()) {
+        return ERROR_BUSY;
+    }
+
+    for(i = 0; i < length; ++i) {
+        UART_txBuffer[u8Head] = pData[i];
+        u8Head = (u8_t)(u8Head + 1U) & UART_TX_BUFFER_MASK;
+    }
+
+    /* Publish the bytes, then wake the transmitter */
+    UART_txHead = u8Head;
+
+    GIE_Disable();
+    BIT_SET(UCSRB, UDRIE);
+    GIE_Enable();
+
+    return ERROR_OK;
+}
+
+u8_t UART_GetTxSpace(void) {
+    return (u8_t)(UART_txTail - UART_txHead - 1U) & UART_TX_BUFFER_MASK;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                              ISR FUNCTIONS                                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/* ISR of USART Receive Complete */
+void __vector_13(void) __attribute__((signal));
+void __vector_13(void) {
+    u8_t u8Status = 0;
+    u8_t u8Byte = 0;
+    u8_t u8Next = 0;
+
+    GIE_Disable();
+
+    /* The status is valid for the byte in UDR, read it first */
+    u8Status = UCSRA;
+    u8Byte = UDR;
+
+    u8Next = (u8_t)(UART_rxHead + 1U) & UART_RX_BUFFER_MASK;
+
+    if( (0 == (u8Status & ((1U << FE) | (1U << DOR)))) && (u8Next != UART_rxTail) ) {
+        UART_rxBuffer[UART_rxHead] = u8Byte;
+        UART_rxHead = u8Next;
+    }
+
+    GIE_Enable();
+}
+
+/* ISR of USART Data Register Empty */
+void __vector_14(void) __attribute__((signal));
+void __vector_14(void) {
+    u8_t u8Tail = UART_txTail;
+
+    GIE_Disable();
+
+    if(u8Tail != UART_txHead) {
+        UDR = UART_txBuffer[u8Tail];
+        UART_txTail = (u8_t)(u8Tail + 1U) & UART_TX_BUFFER_MASK;
+    } else {
+        /* Nothing more to send */
+        BIT_CLR(UCSRB, UDRIE);
+    }
+
+    GIE_Enable();
+}
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * @file        UART.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref UART.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef UART_H
+#define UART_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the USART, see UART_cfg.h
+ * @details     Both directions are interrupt driven: the receive complete ISR 
+ *              stores each byte in the receive ring, the data register empty 
+ *              ISR sends the transmit ring. The application never waits for 
+ *              the line.
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t UART_Init(void);
+
+/******************************************************************************
+ * @brief       Take the oldest received byte
+ * @details     Never blocks. The bytes received with a frame or overrun error,
+ *              or while the ring was full, are dropped.
+ * @param[out]  pByte: the byte
+ * @return      ERROR_t: ERROR_OK if a byte was read, ERROR_NOK if the ring is 
+ *              empty. See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t UART_Receive(u8_t * const pByte);
+
+/******************************************************************************
+ * @brief       Queue bytes to send
+ * @details     Never blocks, the bytes are copied into the transmit ring: all 
+ *              of them, or none if they do not fit.
+ * @param[in]   pData: the bytes
+ * @param[in]   length: their number
+ * @return      ERROR_t: ERROR_BUSY if the ring has not room for all the bytes.
+ *              See \ref ERROR_t
+ *****************************************************************************/
+ERROR_t UART_Send(const u8_t * const pData, const u8_t length);
+
+/******************************************************************************
+ * @brief       Room left in the transmit ring
+ * @details     Only grows until the next \ref UART_Send, the ISR only takes 
+ *              bytes out.
+ * @return      u8_t: the number of bytes that can be queued
+ *****************************************************************************/
+u8_t UART_GetTxSpace(void);
+
+
+#endif      /* UART_H */
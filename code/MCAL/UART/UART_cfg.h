@@ -0,0 +1,27 @@
+/******************************************************************************
+ * @file        UART_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref UART.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef UART_CFG_H
+#define UART_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Baud rate, 8 data bits, no parity, 1 stop bit */
+#define UART_BAUD_RATE          (38400UL)
+
+/*!< Ring buffers, powers of 2. One byte of each stays unused. The receive ring
+     only has to hold the bytes coming between two polls of the application, 
+     the transmit ring a whole reply frame */
+#define UART_RX_BUFFER_SIZE     (16U)
+#define UART_TX_BUFFER_SIZE     (64U)
+
+#endif      /* UART_CFG_H */
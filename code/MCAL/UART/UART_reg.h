@@ -0,0 +1,58 @@
+/**************************************************************************
+ * @file        UART_reg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       USART Registers of ATmega32 MCU
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **************************************************************************/
+#ifndef UART_REG_H
+#define UART_REG_H
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              CHANGE THIS PART ONLY FOR NEW DEVICES                         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define UDR        (* ((volatile u8_t *) 0x2C) )    /* USART I/O Data Register */
+#define UCSRA      (* ((volatile u8_t *) 0x2B) )    /* USART Control and Status Register A */
+#define UCSRB      (* ((volatile u8_t *) 0x2A) )    /* USART Control and Status Register B */
+#define UBRRL      (* ((volatile u8_t *) 0x29) )    /* USART Baud Rate Register Low */
+#define UCSRC      (* ((volatile u8_t *) 0x40) )    /* USART Control and Status Register C, URSEL = 1 */
+#define UBRRH      (* ((volatile u8_t *) 0x40) )    /* USART Baud Rate Register High, URSEL = 0 */
+
+enum {
+    MPCM,                                           /* Multi-processor Communication Mode */
+    U2X,                                            /* Double the USART Transmission Speed */
+    PE,                                             /* Parity Error */
+    DOR,                                            /* Data OverRun */
+    FE,                                             /* Frame Error */
+    UDRE,                                           /* USART Data Register Empty */
+    TXC,                                            /* USART Transmit Complete */
+    RXC,                                            /* USART Receive Complete */
+};  /* UCSRA: USART Control and Status Register A */
+
+enum {
+    TXB8,                                           /* Transmit Data Bit 8 */
+    RXB8,                                           /* Receive Data Bit 8 */
+    UCSZ2,                                          /* Character Size Bit 2 */
+    TXEN,                                           /* Transmitter Enable */
+    RXEN,                                           /* Receiver Enable */
+    UDRIE,                                          /* USART Data Register Empty Interrupt Enable */
+    TXCIE,                                          /* TX Complete Interrupt Enable */
+    RXCIE,                                          /* RX Complete Interrupt Enable */
+};  /* UCSRB: USART Control and Status Register B */
+
+enum {
+    UCPOL,                                          /* Clock Polarity */
+    UCSZ0,                                          /* Character Size Bit 0 */
+    UCSZ1,                                          /* Character Size Bit 1 */
+    USBS,                                           /* Stop Bit Select */
+    UPM0,                                           /* Parity Mode Bit 0 */
+    UPM1,                                           /* Parity Mode Bit 1 */
+    UMSEL,                                          /* USART Mode Select */
+    URSEL,                                          /* Register Select: UCSRC when 1, UBRRH when 0 */
+};  /* UCSRC: USART Control and Status Register C */
+
+#endif      /* UART_REG_H */
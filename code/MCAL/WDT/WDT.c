@@ -0,0 +1,228 @@
+/**************************************************************************
+ * @file        WDT.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Watchdog supervision for Atmega32 microcontroller.
+ * @details     Every activity increments its own check in counter. The tick 
+ *              ISR compares the counters with their previous values each 
+ *              millisecond: an activity whose counter did not move for longer 
+ *              than its deadline has missed.
+ *              The hardware watchdog is fed from the tick only while no 
+ *              activity missed. The first activity that missed is kept in a
+ *              .noinit record, that survives the watchdog reset.
+ *              The reset flags of MCUCSR are taken by the startup code, 
+ *              before any driver is initialized.
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ***************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "../../LIB/BIT_MATH.h"
+
+#include "../GIE/GIE.h"
+#include "../TIMER/TIMER.h"
+
+#include "WDT_reg.h"
+#include "WDT.h"
+#include "WDT_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                      PRIVATE FUNCTIONS PROTOTYPES                          */
+/*                                                                            */                              
+/*----------------------------------------------------------------------------*/
+static void WDT_Service(void);
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                            MACRO LIKE FUNCTIONS                            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define ASSERT_ACTIVITY(activity)   ( activity < NUM_OF_WDT_ACTIVITIES )
+
+/*!< The record is valid only if its check byte matches, RAM is random at power on */
+#define WDT_RECORD_CHECK(missed)    ( (u8_t)((missed) ^ 0xFFU) )
+#define WDT_RECORD_IS_VALID(record) ( 0xFFU == (u8_t)((record).missed ^ (record).check) )
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Kept across the watchdog reset */
+typedef struct {
+    u8_t    missed;
+    u8_t    check;
+}WDT_RECORD_t;
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                           PRIVATE GLOBALS VARIABLES                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*!< Not cleared by the startup code */
+static WDT_RECORD_t WDT_record __attribute__((section(".noinit")));
+
+/*!< Reset flags of MCUCSR, taken by WDT_EarlyInit */
+static u8_t WDT_resetFlags = 0;
+
+/*!< Cause of the last reset, taken from the record by WDT_Init */
+static WDT_ACTIVITY_t WDT_resetCause = WDT_ACTIVITY_NONE;
+
+/*!< Incremented by the activities, and their value at the last change seen */
+static volatile u8_t WDT_checkIns[NUM_OF_WDT_ACTIVITIES];
+static u8_t WDT_lastCheckIns[NUM_OF_WDT_ACTIVITIES];
+
+/*!< Time of the last change seen, counted by the service in ms */
+static u16_t WDT_lastSeenMs[NUM_OF_WDT_ACTIVITIES];
+static u16_t WDT_nowMs = 0;
+
+/*!< Latched at the first miss: the hardware watchdog is no more fed */
+static BOOL_t WDT_isMissed = FALSE;
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PUBLIC FUNCTIONS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+ERROR_t WDT_Init(void) {
+    ERROR_t error = ERROR_OK;
+    u8_t i = 0;
+
+    /* Without a record, the watchdog reset came from the tick itself */
+    if(BIT_IS_SET(WDT_resetFlags, WDRF)) {
+        if( WDT_RECORD_IS_VALID(WDT_record) && ASSERT_ACTIVITY(WDT_record.missed) ) {
+            WDT_resetCause = (WDT_ACTIVITY_t)WDT_record.missed;
+        } else {
+            WDT_resetCause = WDT_ACTIVITY_TICK;
+        }
+    } else {
+        WDT_resetCause = WDT_ACTIVITY_NONE;
+    }
+
+    WDT_record.missed = WDT_ACTIVITY_NONE;
+    WDT_record.check = WDT_RECORD_CHECK(WDT_ACTIVITY_NONE);
+
+    for(i = 0; i < countWdtConfigured; ++i) {
+        if( !ASSERT_ACTIVITY(wdtConfigs[i].activity) || (WDT_ACTIVITY_TICK == wdtConfigs[i].activity) ) {
+            error |= ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    GIE_Disable();
+
+    WDT_nowMs = 0;
+    WDT_isMissed = FALSE;
+
+    for(i = 0; i < NUM_OF_WDT_ACTIVITIES; ++i) {
+        WDT_lastCheckIns[i] = WDT_checkIns[i];
+        WDT_lastSeenMs[i] = 0;
+    }
+
+    WDT_RESET();
+    WDTCR = (1U << WDE) | (u8_t)WDT_TIMEOUT;
+
+    GIE_Enable();
+
+    error |= TIMER_TickAddCallback(WDT_Service);
+
+    return error;
+}
+
+void WDT_CheckIn(const WDT_ACTIVITY_t activity) {
+    if(ASSERT_ACTIVITY(activity)) {
+        /* Only the owner of the activity writes its counter */
+        WDT_checkIns[activity]++;
+    }
+}
+
+WDT_ACTIVITY_t WDT_GetResetCause(void) {
+    return WDT_resetCause;
+}
+
+WDT_RESET_t WDT_GetResetSource(void) {
+    WDT_RESET_t source = WDT_RESET_POWER_ON;
+
+    if(BIT_IS_SET(WDT_resetFlags, PORF)) {
+        source = WDT_RESET_POWER_ON;
+    } else if(BIT_IS_SET(WDT_resetFlags, EXTRF)) {
+        source = WDT_RESET_EXTERNAL;
+    } else if(BIT_IS_SET(WDT_resetFlags, BORF)) {
+        source = WDT_RESET_BROWN_OUT;
+    } else if(BIT_IS_SET(WDT_resetFlags, WDRF)) {
+        source = WDT_RESET_WATCHDOG;
+    } else if(BIT_IS_SET(WDT_resetFlags, JTRF)) {
+        source = WDT_RESET_JTAG;
+    } else {
+        /* No flag: a jump to the reset vector, RAM is not trusted */
+    }
+
+    return source;
+}
+
+void WDT_Stop(void) {
+    WDT_RESET();
+
+    /* Timed sequence */
+    WDTCR = (1U << WDTOE) | (1U << WDE);
+    WDTCR = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                              EARLY INIT                                    */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Take and clear the reset flags
+ * @details Placed in .init5 by the linker: it runs after .bss is cleared, and 
+ *          before main. The flags are cleared so that the next reset sets 
+ *          its own flag only. Naked, as the init sections fall through into
+ *          each other.
+ ******************************************************************************/
+void WDT_EarlyInit(void) __attribute__((naked, used, section(".init5")));
+void WDT_EarlyInit(void) {
+    WDT_resetFlags = MCUCSR & WDT_RESET_FLAGS;
+    MCUCSR &= (u8_t)~WDT_RESET_FLAGS;
+}
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                          PRIVATE FUNCTIONS                                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Check the deadlines, and feed the hardware watchdog if all are met
+ * @details Tick callback, called every millisecond
+ ******************************************************************************/
+static void WDT_Service(void) {
+    WDT_ACTIVITY_t activity = WDT_ACTIVITY_NONE;
+    u8_t u8CheckIns = 0;
+    u8_t i = 0;
+
+    WDT_nowMs++;
+
+    for(i = 0; i < countWdtConfigured; ++i) {
+        activity = wdtConfigs[i].activity;
+        u8CheckIns = WDT_checkIns[activity];
+
+        if(u8CheckIns != WDT_lastCheckIns[activity]) {
+            WDT_lastCheckIns[activity] = u8CheckIns;
+            WDT_lastSeenMs[activity] = WDT_nowMs;
+        } else if( ((u16_t)(WDT_nowMs - WDT_lastSeenMs[activity]) > wdtConfigs[i].deadlineMs) && !WDT_isMissed ) {
+            WDT_isMissed = TRUE;
+            WDT_record.missed = activity;
+            WDT_record.check = WDT_RECORD_CHECK(activity);
+        } else {
+            /* Within its deadline */
+        }
+    }
+
+    if(!WDT_isMissed) {
+        WDT_RESET();
+    }
+}
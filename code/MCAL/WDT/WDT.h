@@ -0,0 +1,113 @@
+/******************************************************************************
+ * @file        WDT.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Interfaces header file for \ref WDT.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef WDT_H
+#define WDT_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                                  TYPEDEFS                                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief   Activities supervised by the watchdog. Each one must check in 
+ *          within its deadline set in WDT_cfg.c
+ * @note    WDT_ACTIVITY_TICK is the tick ISR running the supervision itself:
+ *          it needs no check in, the hardware watchdog resets the MCU when
+ *          it stops
+ *****************************************************************************/
+typedef enum {
+    WDT_ACTIVITY_CONTROL_LOOP,      /*!< APP_Start loop                 */
+    WDT_ACTIVITY_INPUTS,            /*!< Cars' detector read            */
+    WDT_ACTIVITY_TICK,              /*!< 1 ms tick ISR                  */
+
+    NUM_OF_WDT_ACTIVITIES,
+    WDT_ACTIVITY_NONE = NUM_OF_WDT_ACTIVITIES
+}WDT_ACTIVITY_t;
+
+/******************************************************************************
+ * @brief   Source of the last reset, from the flags of MCUCSR. When several 
+ *          flags are set, the first one of this list is taken
+ *****************************************************************************/
+typedef enum {
+    WDT_RESET_POWER_ON,             /*!< Power on, RAM is random        */
+    WDT_RESET_EXTERNAL,             /*!< RESET pin                      */
+    WDT_RESET_BROWN_OUT,            /*!< VCC under the BOD level        */
+    WDT_RESET_WATCHDOG,             /*!< Hardware watchdog              */
+    WDT_RESET_JTAG,                 /*!< JTAG reset instruction         */
+
+    NUM_OF_WDT_RESETS
+}WDT_RESET_t;
+
+/******************************************************************************
+ * @brief   Timeout of the hardware watchdog, at VCC = 5 V
+ *****************************************************************************/
+typedef enum {
+    WDT_TIMEOUT_16_MS,
+    WDT_TIMEOUT_32_MS,
+    WDT_TIMEOUT_65_MS,
+    WDT_TIMEOUT_130_MS,
+    WDT_TIMEOUT_260_MS,
+    WDT_TIMEOUT_520_MS,
+    WDT_TIMEOUT_1000_MS,
+    WDT_TIMEOUT_2100_MS,
+}WDT_TIMEOUT_t;
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                               API's PROTOTYPES                             */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief       Start the watchdog supervision
+ * @details     Takes the activity that caused the last reset, enables the 
+ *              hardware watchdog and supervises the activities from the tick.
+ *              The hardware watchdog is fed only while all activities check in
+ *              within their deadlines. After a miss it is never fed again, so 
+ *              the MCU resets within WDT_TIMEOUT.
+ * @pre         \ref TIMER_TickInit
+ * @return      ERROR_t: error code. See \ref ERROR_t for more information.
+ *****************************************************************************/
+ERROR_t WDT_Init(void);
+
+/******************************************************************************
+ * @brief       Tell the watchdog that an activity is alive
+ * @details     Can be called from an ISR
+ * @param[in]   activity: See \ref WDT_ACTIVITY_t
+ *****************************************************************************/
+void WDT_CheckIn(const WDT_ACTIVITY_t activity);
+
+/******************************************************************************
+ * @brief       Get the activity that missed its deadline before the last reset
+ * @return      WDT_ACTIVITY_t: WDT_ACTIVITY_NONE if the last reset was not
+ *              caused by the watchdog
+ *****************************************************************************/
+WDT_ACTIVITY_t WDT_GetResetCause(void);
+
+/******************************************************************************
+ * @brief       Get the source of the last reset
+ * @details     The flags of MCUCSR are taken and cleared by the startup code,
+ *              so this is valid before \ref WDT_Init
+ * @return      WDT_RESET_t: See \ref WDT_RESET_t
+ *****************************************************************************/
+WDT_RESET_t WDT_GetResetSource(void);
+
+/******************************************************************************
+ * @brief       Stop the hardware watchdog until the next reset
+ * @details     For the failsafe, which must not be reset into the normal 
+ *              operation. Has no effect when the WDTON fuse is programmed.
+ * @pre         Interrupts disabled: WDE must be cleared within 4 cycles of 
+ *              setting WDTOE
+ *****************************************************************************/
+void WDT_Stop(void);
+
+
+#endif      /* WDT_H */
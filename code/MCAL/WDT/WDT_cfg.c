@@ -0,0 +1,36 @@
+/******************************************************************************
+ * @file        WDT_cfg.c
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration source file for \ref WDT.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#include "../../LIB/STD_TYPES.h"
+#include "WDT.h"
+#include "WDT_cfg.h"
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     CHANGE THE FOLLOWING TO YOUR NEEDS                     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/*****************************************************************************
+ * @note    WDT_ACTIVITY_TICK must not be configured, it is supervised by the
+ *          hardware watchdog directly.
+ *          The control loop never blocks, 100 ms leaves room for the startup
+ *          and the EEPROM driver.
+ *****************************************************************************/
+WDT_CONFIGS_t wdtConfigs[] = {
+    {WDT_ACTIVITY_CONTROL_LOOP,  100},
+    {WDT_ACTIVITY_INPUTS,        100},
+};
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                     DO NOT CHANGE ANYTHING BELOW THIS LINE                 */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+const u8_t countWdtConfigured = sizeof(wdtConfigs) / sizeof(wdtConfigs[0]);
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * @file        WDT_cfg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Configuration header file for \ref WDT.c
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ ******************************************************************************/
+#ifndef WDT_CFG_H
+#define WDT_CFG_H
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                   CHANGE THIS PART TO YOUR NEEDS                           */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @brief Timeout of the hardware watchdog. See \ref WDT_TIMEOUT_t
+ *        It bounds the time the lamps stay frozen when the tick stops.
+ *****************************************************************************/
+#define WDT_TIMEOUT     WDT_TIMEOUT_260_MS
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*                    DO NOT CHANGE ANYTHING BELOW THIS LINE                  */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+/******************************************************************************
+ * @note    Members:
+ *          - activity:     The activity. See \ref WDT_ACTIVITY_t
+ *          - deadlineMs:   Longest time allowed between two check ins
+ *****************************************************************************/
+typedef struct {
+    WDT_ACTIVITY_t      activity;
+    u16_t               deadlineMs;
+}WDT_CONFIGS_t;
+
+extern WDT_CONFIGS_t wdtConfigs[];
+extern const u8_t countWdtConfigured;
+
+#endif      /* WDT_CFG_H */
@@ -0,0 +1,43 @@
+/**************************************************************************
+ * @file        WDT_reg.h
+ * @author      Mahmoud Karam (ma.karam272@gmail.com)
+ * @brief       Watchdog Timer Registers of ATmega32 MCU
+ * @version     1.0.0
+ * @date        2026-10-19
+ * @copyright   Copyright (c) 2022
+ **************************************************************************/
+#ifndef WDT_REG_H
+#define WDT_REG_H
+
+
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*              CHANGE THIS PART ONLY FOR NEW DEVICES                         */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+#define WDTCR      (* ((volatile u8_t *) 0x41) )    /* Watchdog Timer Control Register */
+#define MCUCSR     (* ((volatile u8_t *) 0x54) )    /* MCU Control and Status Register */
+
+enum {
+	WDP0,                                           /* Watchdog Timer Prescaler 0 */
+	WDP1,                                           /* Watchdog Timer Prescaler 1 */
+	WDP2,                                           /* Watchdog Timer Prescaler 2 */
+	WDE,                                            /* Watchdog Enable */
+	WDTOE,                                          /* Watchdog Turn-off Enable */
+};	/* WDTCR	*/
+
+enum {
+	PORF,                                           /* Power-on Reset Flag */
+	EXTRF,                                          /* External Reset Flag */
+	BORF,                                           /* Brown-out Reset Flag */
+	WDRF,                                           /* Watchdog Reset Flag */
+	JTRF,                                           /* JTAG Reset Flag */
+};	/* MCUCSR	*/
+
+/*!< The reset flags of MCUCSR, ISC2 and JTD are not touched */
+#define WDT_RESET_FLAGS ( (1U << PORF) | (1U << EXTRF) | (1U << BORF) | (1U << WDRF) | (1U << JTRF) )
+
+/*!< Reset the watchdog timer */
+#define WDT_RESET()     __asm__ __volatile__ ("wdr")
+
+#endif    /* WDT_REG_H */
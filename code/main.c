@@ -7,6 +7,7 @@
  * @copyright Mahmoud Karam Emara 2022, MIT License
  ***************************************************************************/
 
+#include "LIB/STD_TYPES.h"
 #include "APP/app.h"
 
 int main (void){    